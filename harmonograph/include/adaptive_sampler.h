@@ -0,0 +1,181 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "curve.h"
+#include "harmonograph.h"
+#include "pendulum_bank.h"
+#include "simd_math.h"
+
+struct AdaptiveParams{
+    double t0 = 0.0;
+    double duration = 1000.0;
+    // largest allowed distance, in pixels, between the drawn chord and the
+    // true curve
+    double tolerance = 0.1;
+    double minStep = 1e-4;
+    // caps the step on straight stretches so the color gradient stays smooth
+    double maxStep = 0.5;
+    float centerX = 400;
+    float centerY = 400;
+};
+
+// Samples a harmonograph with steps sized from its local curvature instead
+// of a fixed dt. A chord of parameter length h deviates from the curve by
+// about a⊥ × h² / 8, where a⊥ is the acceleration normal to the direction
+// of travel, so h = sqrt(8 × tolerance / a⊥) keeps every chord within
+// tolerance pixels. Flat, slow stretches get long steps and tight loops
+// get short ones.
+class AdaptiveSampler{
+    private:
+    using Ops = simd::NativeOps;
+    using vec = Ops::vec;
+
+    // Every pendulum, x axis first, structure-of-arrays and padded with
+    // silent (zero-amplitude) pendulums to a whole number of SIMD blocks.
+    // Both axes share the blocks, so the usual 2+2 setup is one AVX2 block.
+    std::vector<double> amplitude;
+    std::vector<double> frequency;
+    std::vector<double> phase;
+    std::vector<double> damping;
+    std::size_t countX = 0;
+
+    struct State {
+        double x, y;
+        double vx, vy;
+        double ax, ay;
+    };
+
+    // Per-pendulum terms of one evaluation, summed per axis afterwards
+    struct Scratch {
+        std::vector<double> position;
+        std::vector<double> velocity;
+        std::vector<double> acceleration;
+
+        explicit Scratch(std::size_t n) : position(n), velocity(n), acceleration(n) {}
+    };
+
+    void add(const Pendulum& p) {
+        amplitude.push_back(p.getAmplitude());
+        frequency.push_back(p.getFrequency());
+        phase.push_back(p.getPhase());
+        damping.push_back(p.getDamping());
+    }
+
+    // Position, velocity and acceleration at t, with SIMD lanes running
+    // across the pendulums. The three share the decay and the angle, so
+    // each pendulum costs one exp and one sincos.
+    State stateAt(double t, Scratch& scratch) const {
+        vec time = Ops::set1(t);
+        vec negTime = Ops::set1(-t);
+        for (std::size_t i = 0; i < amplitude.size(); i += Ops::width) {
+            vec f = Ops::load(&frequency[i]);
+            vec d = Ops::load(&damping[i]);
+            vec decay = Ops::mul(Ops::load(&amplitude[i]), simd::exp<Ops>(Ops::mul(d, negTime)));
+            vec sine;
+            vec cosine;
+            simd::sincos<Ops>(Ops::add(Ops::mul(f, time), Ops::load(&phase[i])), sine, cosine);
+            sine = Ops::mul(decay, sine);
+            cosine = Ops::mul(decay, cosine);
+
+            // x = e·sin θ, v = e·(f cos θ - d sin θ),
+            // a = e·((d² - f²) sin θ - 2 d f cos θ)
+            vec df = Ops::mul(d, f);
+            vec square = Ops::sub(Ops::mul(d, d), Ops::mul(f, f));
+            Ops::store(&scratch.position[i], sine);
+            Ops::store(&scratch.velocity[i], Ops::sub(Ops::mul(f, cosine), Ops::mul(d, sine)));
+            Ops::store(&scratch.acceleration[i], Ops::sub(Ops::mul(square, sine), Ops::mul(Ops::add(df, df), cosine)));
+        }
+
+        State s{0, 0, 0, 0, 0, 0};
+        for (std::size_t i = 0; i < countX; i++) {
+            s.x += scratch.position[i];
+            s.vx += scratch.velocity[i];
+            s.ax += scratch.acceleration[i];
+        }
+        for (std::size_t i = countX; i < amplitude.size(); i++) {
+            s.y += scratch.position[i];
+            s.vy += scratch.velocity[i];
+            s.ay += scratch.acceleration[i];
+        }
+        return s;
+    }
+
+    // acceleration normal to the velocity; falls back to the full
+    // acceleration where the curve almost stops and its direction is unclear
+    static double normalAcceleration(const State& s) {
+        double speed = std::hypot(s.vx, s.vy);
+        if (speed < 1e-9) {
+            return std::hypot(s.ax, s.ay);
+        }
+        return std::fabs(s.vx * s.ay - s.vy * s.ax) / speed;
+    }
+
+    // Always within [minStep, maxStep]: a NaN h (from a NaN tolerance or
+    // acceleration) falls back to minStep so the sampling loop still ends
+    static double stepFor(double accel, const AdaptiveParams& params) {
+        double h = accel > 0.0 ? std::sqrt(8.0 * params.tolerance / accel) : params.maxStep;
+        if (!(h >= params.minStep)) {
+            return params.minStep;
+        }
+        return std::min(h, params.maxStep);
+    }
+
+    public:
+    explicit AdaptiveSampler(const PendulumBank& bank) {
+        for (std::size_t i = 0; i < bank.sizeX(); i++) {
+            add(bank.getX(i));
+        }
+        countX = amplitude.size();
+        for (std::size_t i = 0; i < bank.sizeY(); i++) {
+            add(bank.getY(i));
+        }
+        while (amplitude.size() % Ops::width != 0) {
+            add(Pendulum(0.0, 0.0, 0.0, 0.0));
+        }
+    }
+
+    // Fills out with the adaptively sampled curve in screen coordinates
+    void sample(const AdaptiveParams& params, CurveBuffer& out) const {
+        std::vector<float> px;
+        std::vector<float> py;
+        std::vector<Color> colors;
+
+        double end = params.t0 + params.duration;
+        double t = params.t0;
+        Scratch scratch(amplitude.size());
+        State s = stateAt(t, scratch);
+        double accel = normalAcceleration(s);
+        while (true) {
+            px.push_back(params.centerX + static_cast<float>(s.x));
+            py.push_back(params.centerY + static_cast<float>(s.y));
+            colors.push_back(curveColor(t));
+            if (t >= end) {
+                break;
+            }
+
+            // predict from the curvature here, then shrink if the curve
+            // bends harder at the far end of the step. An accepted
+            // look-ahead becomes the next point as it is.
+            double h = stepFor(accel, params);
+            State ahead = stateAt(std::min(t + h, end), scratch);
+            double aheadAccel = normalAcceleration(ahead);
+            double shorter = stepFor(aheadAccel, params);
+            if (shorter < h) {
+                t = std::min(t + shorter, end);
+                s = stateAt(t, scratch);
+                accel = normalAcceleration(s);
+            } else {
+                t = std::min(t + h, end);
+                s = ahead;
+                accel = aheadAccel;
+            }
+        }
+
+        out.resize(px.size());
+        std::copy(px.begin(), px.end(), out.x());
+        std::copy(py.begin(), py.end(), out.y());
+        std::copy(colors.begin(), colors.end(), out.color());
+    }
+};
@@ -0,0 +1,121 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "curve.h"
+
+// Offscreen RGB image with float channels in [0, 1]. Lines are blended
+// onto it with Xiaolin Wu's anti-aliasing, so no window or GPU is needed.
+class Canvas{
+    private:
+    int width;
+    int height;
+    std::vector<float> pixels;
+
+    static float fpart(float v) { return v - std::floor(v); }
+    static float rfpart(float v) { return 1.0f - fpart(v); }
+
+    // Blend rgb over pixel (x, y) if it lies in rows [rowBegin, rowEnd)
+    void plot(int x, int y, const float* rgb, float alpha, int rowBegin, int rowEnd) {
+        if (x < 0 || x >= width || y < rowBegin || y >= rowEnd || alpha <= 0.0f) {
+            return;
+        }
+        float* p = &pixels[(static_cast<std::size_t>(y) * width + x) * 3];
+        p[0] += (rgb[0] - p[0]) * alpha;
+        p[1] += (rgb[1] - p[1]) * alpha;
+        p[2] += (rgb[2] - p[2]) * alpha;
+    }
+
+    public:
+    Canvas(int w, int h, Color background = Color{30, 30, 30, 255})
+        : width(w), height(h), pixels(static_cast<std::size_t>(w) * h * 3) {
+        clear(background);
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const float* data() const { return pixels.data(); }
+
+    void clear(Color background) {
+        for (std::size_t i = 0; i < pixels.size(); i += 3) {
+            pixels[i] = background.r / 255.0f;
+            pixels[i + 1] = background.g / 255.0f;
+            pixels[i + 2] = background.b / 255.0f;
+        }
+    }
+
+    // Anti-aliased line from (x0, y0) to (x1, y1), only touching rows
+    // [rowBegin, rowEnd). Pixels are computed the same way whatever the row
+    // range, so a line drawn band by band matches one drawn in a single pass.
+    void drawLine(float x0, float y0, float x1, float y1, Color color, int rowBegin, int rowEnd) {
+        const float rgb[3] = {color.r / 255.0f, color.g / 255.0f, color.b / 255.0f};
+        const float alpha = color.a / 255.0f;
+
+        bool steep = std::fabs(y1 - y0) > std::fabs(x1 - x0);
+        if (steep) {
+            std::swap(x0, y0);
+            std::swap(x1, y1);
+        }
+        if (x0 > x1) {
+            std::swap(x0, x1);
+            std::swap(y0, y1);
+        }
+
+        auto put = [&](int major, int minor, float coverage) {
+            if (steep) {
+                plot(minor, major, rgb, coverage * alpha, rowBegin, rowEnd);
+            } else {
+                plot(major, minor, rgb, coverage * alpha, rowBegin, rowEnd);
+            }
+        };
+
+        float dx = x1 - x0;
+        float dy = y1 - y0;
+        float gradient = dx == 0.0f ? 1.0f : dy / dx;
+
+        // first endpoint
+        float xEnd = std::round(x0);
+        float yEnd = y0 + gradient * (xEnd - x0);
+        float xGap = rfpart(x0 + 0.5f);
+        int xStart = static_cast<int>(xEnd);
+        int yStart = static_cast<int>(std::floor(yEnd));
+        put(xStart, yStart, rfpart(yEnd) * xGap);
+        put(xStart, yStart + 1, fpart(yEnd) * xGap);
+        float intery = yEnd + gradient;
+
+        // second endpoint
+        xEnd = std::round(x1);
+        yEnd = y1 + gradient * (xEnd - x1);
+        xGap = fpart(x1 + 0.5f);
+        int xStop = static_cast<int>(xEnd);
+        int yStop = static_cast<int>(std::floor(yEnd));
+        if (xStop != xStart) {
+            put(xStop, yStop, rfpart(yEnd) * xGap);
+            put(xStop, yStop + 1, fpart(yEnd) * xGap);
+        }
+
+        for (int x = xStart + 1; x < xStop; x++) {
+            int y = static_cast<int>(std::floor(intery));
+            put(x, y, rfpart(intery));
+            put(x, y + 1, fpart(intery));
+            intery += gradient;
+        }
+    }
+
+    void drawLine(float x0, float y0, float x1, float y1, Color color) {
+        drawLine(x0, y0, x1, y1, color, 0, height);
+    }
+
+    // 8-bit interleaved RGB, row-major from the top
+    std::vector<std::uint8_t> toRGB8() const {
+        std::vector<std::uint8_t> out(pixels.size());
+        for (std::size_t i = 0; i < pixels.size(); i++) {
+            float v = std::min(std::max(pixels[i], 0.0f), 1.0f);
+            out[i] = static_cast<std::uint8_t>(v * 255.0f + 0.5f);
+        }
+        return out;
+    }
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdlib>
+#include <map>
+#include <string>
+
+// Minimal "--name value" / "--name=value" parser for the command-line
+// tools. A name followed by another option (or nothing) is a flag.
+class CliArgs{
+    private:
+    std::map<std::string, std::string> values;
+
+    public:
+    CliArgs(int argc, char** argv) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg.rfind("--", 0) != 0) {
+                continue;
+            }
+            arg = arg.substr(2);
+            std::size_t eq = arg.find('=');
+            if (eq != std::string::npos) {
+                values[arg.substr(0, eq)] = arg.substr(eq + 1);
+            } else if (i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0) {
+                values[arg] = argv[++i];
+            } else {
+                values[arg] = "";
+            }
+        }
+    }
+
+    bool has(const std::string& name) const { return values.count(name) != 0; }
+
+    std::string get(const std::string& name, const std::string& fallback) const {
+        auto it = values.find(name);
+        return it == values.end() ? fallback : it->second;
+    }
+
+    double getDouble(const std::string& name, double fallback) const {
+        auto it = values.find(name);
+        return it == values.end() ? fallback : std::strtod(it->second.c_str(), nullptr);
+    }
+
+    long getInt(const std::string& name, long fallback) const {
+        auto it = values.find(name);
+        return it == values.end() ? fallback : std::strtol(it->second.c_str(), nullptr, 10);
+    }
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Color{
+    std::uint8_t r;
+    std::uint8_t g;
+    std::uint8_t b;
+    std::uint8_t a;
+};
+
+// Color gradient based on time
+inline Color curveColor(double t) {
+    float ratio = t / 100.0f;
+    return Color{
+        static_cast<std::uint8_t>(128 + 127 * std::sin(ratio * 3)),
+        static_cast<std::uint8_t>(128 + 127 * std::sin(ratio * 5 + 1)),
+        static_cast<std::uint8_t>(128 + 127 * std::sin(ratio * 7 + 2)),
+        255
+    };
+}
+
+// Read-only view of a generated curve, in screen coordinates. Points are
+// stored as separate x/y/color arrays so the same view can sit on top of a
+// CurveBuffer or any other storage.
+struct CurveView{
+    const float* x = nullptr;
+    const float* y = nullptr;
+    const Color* color = nullptr;
+    std::size_t count = 0;
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    CurveView slice(std::size_t begin, std::size_t end) const {
+        return CurveView{x + begin, y + begin, color + begin, end - begin};
+    }
+};
+
+// Owning storage for a generated curve
+class CurveBuffer{
+    private:
+    std::vector<float> xs;
+    std::vector<float> ys;
+    std::vector<Color> colors;
+
+    public:
+    void resize(std::size_t n) {
+        xs.resize(n);
+        ys.resize(n);
+        colors.resize(n);
+    }
+
+    void clear() {
+        xs.clear();
+        ys.clear();
+        colors.clear();
+    }
+
+    std::size_t size() const { return xs.size(); }
+
+    float* x() { return xs.data(); }
+    float* y() { return ys.data(); }
+    Color* color() { return colors.data(); }
+
+    CurveView view() const { return CurveView{xs.data(), ys.data(), colors.data(), xs.size()}; }
+
+    void swap(CurveBuffer& other) {
+        xs.swap(other.xs);
+        ys.swap(other.ys);
+        colors.swap(other.colors);
+    }
+};
@@ -0,0 +1,264 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "curve.h"
+#include "curve_generator.h"
+#include "pendulum_bank.h"
+
+// On-disk cache of generated curves. A file is a fixed header, the
+// pendulum parameters, then the packed x, y and RGBA arrays, each starting
+// on a 64-byte boundary. Loading is a single mmap; the CurveView points
+// straight into the mapping, nothing is parsed or copied. Files use the
+// host's byte order and are only meant to be read back on the same kind
+// of machine.
+//
+// Layout:
+//   CurveFileHeader
+//   double[4 * (pendulumsX + pendulumsY)]   amplitude, frequency, phase, damping
+//   float[count]  x        at xOffset
+//   float[count]  y        at yOffset
+//   Color[count]  rgba     at colorOffset
+struct CurveFileHeader{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t pendulumsX;
+    std::uint32_t pendulumsY;
+    std::uint32_t reserved;
+    std::uint64_t key;
+    double t0;
+    double dt;
+    std::uint64_t count;
+    float centerX;
+    float centerY;
+    float scale;
+    float reserved2;
+    std::uint64_t xOffset;
+    std::uint64_t yOffset;
+    std::uint64_t colorOffset;
+    std::uint64_t fileSize;
+};
+
+constexpr char kCurveFileMagic[8] = {'H', 'G', 'C', 'U', 'R', 'V', 'E', '\0'};
+constexpr std::uint32_t kCurveFileVersion = 1;
+
+namespace curve_cache_detail {
+
+inline std::size_t alignUp(std::size_t v) { return (v + 63) & ~static_cast<std::size_t>(63); }
+
+inline std::vector<double> pendulumParams(const PendulumBank& bank) {
+    std::vector<double> values;
+    auto add = [&](const Pendulum& p) {
+        values.push_back(p.getAmplitude());
+        values.push_back(p.getFrequency());
+        values.push_back(p.getPhase());
+        values.push_back(p.getDamping());
+    };
+    for (std::size_t i = 0; i < bank.sizeX(); i++) {
+        add(bank.getX(i));
+    }
+    for (std::size_t i = 0; i < bank.sizeY(); i++) {
+        add(bank.getY(i));
+    }
+    return values;
+}
+
+// Header with every field that identifies the curve filled in
+inline CurveFileHeader makeHeader(const PendulumBank& bank, const CurveParams& params) {
+    CurveFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kCurveFileMagic, sizeof(header.magic));
+    header.version = kCurveFileVersion;
+    header.pendulumsX = static_cast<std::uint32_t>(bank.sizeX());
+    header.pendulumsY = static_cast<std::uint32_t>(bank.sizeY());
+    header.t0 = params.t0;
+    header.dt = params.dt;
+    header.count = params.count;
+    header.centerX = params.centerX;
+    header.centerY = params.centerY;
+    header.scale = params.scale;
+
+    std::size_t paramBytes = pendulumParams(bank).size() * sizeof(double);
+    header.xOffset = alignUp(sizeof(CurveFileHeader) + paramBytes);
+    header.yOffset = alignUp(header.xOffset + params.count * sizeof(float));
+    header.colorOffset = alignUp(header.yOffset + params.count * sizeof(float));
+    header.fileSize = header.colorOffset + params.count * sizeof(Color);
+    return header;
+}
+
+}  // namespace curve_cache_detail
+
+// 64-bit FNV-1a over everything that determines the curve's points
+inline std::uint64_t curveCacheKey(const PendulumBank& bank, const CurveParams& params) {
+    CurveFileHeader header = curve_cache_detail::makeHeader(bank, params);
+    std::vector<double> values = curve_cache_detail::pendulumParams(bank);
+
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&](const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    mix(&header, sizeof(header));
+    mix(values.data(), values.size() * sizeof(double));
+    return hash;
+}
+
+// Read-only mapping of a curve file
+class MappedCurve{
+    private:
+    void* base = nullptr;
+    std::size_t length = 0;
+    CurveView curve;
+
+    void release() {
+        if (base) {
+            munmap(base, length);
+        }
+        base = nullptr;
+        length = 0;
+        curve = CurveView{};
+    }
+
+    public:
+    MappedCurve() = default;
+    ~MappedCurve() { release(); }
+
+    MappedCurve(const MappedCurve&) = delete;
+    MappedCurve& operator=(const MappedCurve&) = delete;
+
+    MappedCurve(MappedCurve&& other) noexcept : base(other.base), length(other.length), curve(other.curve) {
+        other.base = nullptr;
+        other.length = 0;
+        other.curve = CurveView{};
+    }
+
+    MappedCurve& operator=(MappedCurve&& other) noexcept {
+        if (this != &other) {
+            release();
+            base = other.base;
+            length = other.length;
+            curve = other.curve;
+            other.base = nullptr;
+            other.length = 0;
+            other.curve = CurveView{};
+        }
+        return *this;
+    }
+
+    // Maps path if it holds exactly the curve for bank and params
+    bool open(const std::string& path, const PendulumBank& bank, const CurveParams& params) {
+        release();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(CurveFileHeader)) {
+            ::close(fd);
+            return false;
+        }
+        void* mapping = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+        base = mapping;
+        length = static_cast<std::size_t>(info.st_size);
+
+        // the stored header and parameters must match what we would write
+        CurveFileHeader expected = curve_cache_detail::makeHeader(bank, params);
+        expected.key = curveCacheKey(bank, params);
+        std::vector<double> values = curve_cache_detail::pendulumParams(bank);
+        const char* bytes = static_cast<const char*>(base);
+        if (length != expected.fileSize ||
+            std::memcmp(bytes, &expected, sizeof(expected)) != 0 ||
+            std::memcmp(bytes + sizeof(expected), values.data(), values.size() * sizeof(double)) != 0) {
+            release();
+            return false;
+        }
+
+        curve.x = reinterpret_cast<const float*>(bytes + expected.xOffset);
+        curve.y = reinterpret_cast<const float*>(bytes + expected.yOffset);
+        curve.color = reinterpret_cast<const Color*>(bytes + expected.colorOffset);
+        curve.count = expected.count;
+        return true;
+    }
+
+    bool isOpen() const { return base != nullptr; }
+    CurveView view() const { return curve; }
+};
+
+// Writes a curve file. Goes through a temporary file and a rename, so a
+// concurrent reader never maps a half-written curve.
+inline bool writeCurveFile(const std::string& path, const PendulumBank& bank, const CurveParams& params, const CurveView& curve) {
+    if (curve.size() != params.count) {
+        return false;
+    }
+    CurveFileHeader header = curve_cache_detail::makeHeader(bank, params);
+    header.key = curveCacheKey(bank, params);
+    std::vector<double> values = curve_cache_detail::pendulumParams(bank);
+
+    std::string temp = path + ".tmp" + std::to_string(getpid());
+    std::FILE* file = std::fopen(temp.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    static const char padding[64] = {};
+    std::size_t written = 0;
+    auto put = [&](const void* data, std::size_t size) {
+        written += std::fwrite(data, 1, size, file);
+    };
+    auto padTo = [&](std::size_t offset) {
+        put(padding, offset - written);
+    };
+    put(&header, sizeof(header));
+    put(values.data(), values.size() * sizeof(double));
+    padTo(header.xOffset);
+    put(curve.x, curve.size() * sizeof(float));
+    padTo(header.yOffset);
+    put(curve.y, curve.size() * sizeof(float));
+    padTo(header.colorOffset);
+    put(curve.color, curve.size() * sizeof(Color));
+
+    bool ok = written == header.fileSize;
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Directory of curve files named by their key
+class CurveCache{
+    private:
+    std::string directory;
+
+    public:
+    explicit CurveCache(const std::string& dir) : directory(dir) {
+        ::mkdir(directory.c_str(), 0755);
+    }
+
+    std::string pathFor(const PendulumBank& bank, const CurveParams& params) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.hgc", static_cast<unsigned long long>(curveCacheKey(bank, params)));
+        return directory + "/" + name;
+    }
+
+    bool load(const PendulumBank& bank, const CurveParams& params, MappedCurve& out) const {
+        return out.open(pathFor(bank, params), bank, params);
+    }
+
+    bool store(const PendulumBank& bank, const CurveParams& params, const CurveView& curve) const {
+        return writeCurveFile(pathFor(bank, params), bank, params, curve);
+    }
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include "curve.h"
+#include "pendulum_bank.h"
+#include "thread_pool.h"
+
+// Evenly spaced sampling of a harmonograph: sample i is taken at
+// t = t0 + dt * i and drawn at (centerX + scale * x, centerY + scale * y)
+struct CurveParams{
+    double t0 = 0.0;
+    double dt = 0.01;
+    std::size_t count = 0;
+    float centerX = 400;
+    float centerY = 400;
+    float scale = 1.0f;
+
+    static std::size_t samplesFor(double duration, double dt) {
+        return static_cast<std::size_t>(std::ceil(duration / dt));
+    }
+};
+
+// The functions below take any evaluator with an
+// evaluateRange(t0, dt, begin, end, xs, ys) member and a static
+// blockWidth(): PendulumBank, or Harmonograph<NX, NY> when the pendulum
+// counts are known at compile time.
+
+// Samples [begin, end) of the curve, written to xs/ys/colors[0 .. end-begin)
+template <typename Evaluator>
+inline void generateCurveRange(const Evaluator& evaluator, const CurveParams& params, std::size_t begin, std::size_t end, float* xs, float* ys, Color* colors) {
+    evaluator.evaluateRange(params.t0, params.dt, begin, end, xs, ys);
+    for (std::size_t i = 0; i < end - begin; i++) {
+        xs[i] = params.centerX + params.scale * xs[i];
+        ys[i] = params.centerY + params.scale * ys[i];
+        colors[i] = curveColor(params.t0 + params.dt * (begin + i));
+    }
+}
+
+// Samples [begin, end) of the curve, written to the same indices of out
+template <typename Evaluator>
+inline void generateCurveRange(const Evaluator& evaluator, const CurveParams& params, std::size_t begin, std::size_t end, CurveBuffer& out) {
+    generateCurveRange(evaluator, params, begin, end, out.x() + begin, out.y() + begin, out.color() + begin);
+}
+
+// Default work unit: big enough to amortize scheduling, small enough that
+// a handful of chunks exist per thread for balancing
+constexpr std::size_t kCurveChunkSize = 8192;
+
+// Fills out with params.count samples. With a pool the range is split into
+// chunks computed in parallel; every sample is computed the same way in
+// either case, so the result is bit-identical to the serial one.
+template <typename Evaluator>
+inline void generateCurve(const Evaluator& evaluator, const CurveParams& params, CurveBuffer& out, ThreadPool* pool = nullptr, std::size_t chunkSize = kCurveChunkSize) {
+    out.resize(params.count);
+    if (!pool || pool->size() == 1) {
+        generateCurveRange(evaluator, params, 0, params.count, out);
+        return;
+    }
+
+    // keep chunk starts on SIMD block boundaries so each sample lands in
+    // the same lane position as in the serial pass
+    std::size_t width = Evaluator::blockWidth();
+    chunkSize = (chunkSize + width - 1) / width * width;
+    pool->parallelFor(params.count, chunkSize, [&](std::size_t begin, std::size_t end) {
+        generateCurveRange(evaluator, params, begin, end, out);
+    });
+}
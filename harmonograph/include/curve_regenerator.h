@@ -0,0 +1,127 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "curve.h"
+#include "curve_generator.h"
+#include "pendulum_bank.h"
+
+// Regenerates whole curves on a background thread for live parameter
+// edits. request() only records the latest parameters and returns; the
+// worker fills a back buffer and publishes it, and the render thread picks
+// it up with poll(), which never waits. A newer request cancels the one in
+// flight between chunks, so bursts of edits don't queue up stale work.
+class CurveRegenerator{
+    private:
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    // latest request, guarded by mutex
+    PendulumBank requestedBank;
+    CurveParams requestedParams;
+    std::uint64_t requested = 0;
+
+    // generation being computed; bumped by request() to cancel it
+    std::atomic<std::uint64_t> latest{0};
+
+    // finished curve waiting for the render thread, guarded by mutex
+    CurveBuffer ready;
+    std::uint64_t readyGeneration = 0;
+    std::uint64_t taken = 0;
+
+    CurveBuffer back;
+    std::size_t chunkSize;
+
+    void run() {
+        std::uint64_t built = 0;
+        while (true) {
+            PendulumBank bank;
+            CurveParams params;
+            std::uint64_t generation;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || requested != built; });
+                if (stopping) {
+                    return;
+                }
+                bank = requestedBank;
+                params = requestedParams;
+                generation = requested;
+            }
+            built = generation;
+
+            back.resize(params.count);
+            bool cancelled = false;
+            for (std::size_t begin = 0; begin < params.count; begin += chunkSize) {
+                if (latest.load(std::memory_order_relaxed) != generation) {
+                    cancelled = true;
+                    break;
+                }
+                generateCurveRange(bank, params, begin, std::min(begin + chunkSize, params.count), back);
+            }
+            if (cancelled) {
+                continue;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.swap(back);
+            readyGeneration = generation;
+        }
+    }
+
+    public:
+    explicit CurveRegenerator(std::size_t cancelCheckEvery = 16384)
+        : chunkSize(std::max<std::size_t>(cancelCheckEvery, 1)) {
+        worker = std::thread([this] { run(); });
+    }
+
+    ~CurveRegenerator() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            latest++;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    CurveRegenerator(const CurveRegenerator&) = delete;
+    CurveRegenerator& operator=(const CurveRegenerator&) = delete;
+
+    // Asks for a curve with new parameters, superseding any earlier request
+    void request(const PendulumBank& bank, const CurveParams& params) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            requestedBank = bank;
+            requestedParams = params;
+            requested++;
+            latest.store(requested);
+        }
+        wake.notify_one();
+    }
+
+    // If a curve newer than the last one taken is ready, swaps it into
+    // front and returns true. Only try-locks, so a frame never blocks on the
+    // worker; at worst the swap happens a frame later.
+    bool poll(CurveBuffer& front) {
+        std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+        if (!lock.owns_lock() || readyGeneration == taken) {
+            return false;
+        }
+        front.swap(ready);
+        taken = readyGeneration;
+        return true;
+    }
+
+    // True while a requested curve has not been handed over yet
+    bool busy() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return taken != requested;
+    }
+};
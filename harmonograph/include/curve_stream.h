@@ -0,0 +1,66 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include "curve.h"
+#include "curve_generator.h"
+#include "pendulum_bank.h"
+
+// Resumable, on-demand generator for a curve. Points are computed only when
+// asked for, into one reusable chunk, so memory stays at chunkCapacity
+// points however long the curve is.
+class CurveStream{
+    private:
+    PendulumBank bank;
+    CurveParams params;
+    std::size_t chunkCapacity;
+    std::size_t cursor = 0;
+    std::size_t lastSlot = 0;
+    CurveBuffer chunk;
+
+    public:
+    CurveStream(const PendulumBank& b, const CurveParams& p, std::size_t capacity = 4096)
+        : bank(b), params(p), chunkCapacity(std::max<std::size_t>(capacity, 1)) {
+        chunk.resize(chunkCapacity + 1);
+    }
+
+    // Start again from the first point with new parameters
+    void reset(const PendulumBank& b, const CurveParams& p) {
+        bank = b;
+        params = p;
+        cursor = 0;
+    }
+
+    void reset() { cursor = 0; }
+
+    bool done() const { return cursor >= params.count; }
+    std::size_t position() const { return cursor; }
+    std::size_t size() const { return params.count; }
+    const CurveParams& getParams() const { return params; }
+
+    // Produces up to maxPoints new points (at most chunkCapacity). Except for
+    // the very first chunk, the view starts with the last point of the
+    // previous one so consecutive chunks join up as a line strip. The view
+    // stays valid until the next call.
+    CurveView next(std::size_t maxPoints) {
+        std::size_t begin = cursor;
+        std::size_t end = std::min(begin + std::min(maxPoints, chunkCapacity), params.count);
+        if (begin >= end) {
+            return CurveView{};
+        }
+
+        // slot 0 carries the previous chunk's last point
+        std::size_t offset = 1;
+        if (begin > 0) {
+            chunk.x()[0] = chunk.x()[lastSlot];
+            chunk.y()[0] = chunk.y()[lastSlot];
+            chunk.color()[0] = chunk.color()[lastSlot];
+            offset = 0;
+        }
+        generateCurveRange(bank, params, begin, end, chunk.x() + 1, chunk.y() + 1, chunk.color() + 1);
+
+        std::size_t produced = end - begin;
+        lastSlot = produced;
+        cursor = end;
+        return chunk.view().slice(offset, produced + 1);
+    }
+};
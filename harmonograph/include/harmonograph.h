@@ -1,5 +1,9 @@
 #pragma once
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <utility>
+#include "simd_math.h"
 
 class Pendulum{
     private:
@@ -26,4 +30,182 @@ class Pendulum{
     double getFrequency() const { return frequency; }
     double getPhase() const { return phase; }
     double getDamping() const { return damping; }
+};
+
+// Advances one pendulum over evenly spaced samples t = t0 + dt * i without
+// calling exp/sin per sample. The pendulum is the imaginary part of
+// z(t) = amplitude * e^(-damping * t) * e^(i * (frequency * t + phase)),
+// so moving from t to t + dt is one complex multiply by a fixed step factor.
+// Rounding error grows with every multiply, so every reanchorInterval
+// samples the state is recomputed exactly from t.
+class PendulumStepper{
+    private:
+    Pendulum pendulum;
+    double t0;
+    double dt;
+    std::size_t reanchorInterval;
+    std::size_t index;
+    double re;
+    double im;
+    double stepRe;
+    double stepIm;
+
+    void anchor() {
+        double t = time();
+        double magnitude = pendulum.getAmplitude() * std::exp(-pendulum.getDamping() * t);
+        double angle = pendulum.getFrequency() * t + pendulum.getPhase();
+        re = magnitude * std::cos(angle);
+        im = magnitude * std::sin(angle);
+    }
+
+    public:
+    PendulumStepper(const Pendulum& p, double start, double step, std::size_t reanchorEvery = 1024)
+        : pendulum(p), t0(start), dt(step), reanchorInterval(reanchorEvery ? reanchorEvery : 1), index(0) {
+        double decay = std::exp(-pendulum.getDamping() * dt);
+        stepRe = decay * std::cos(pendulum.getFrequency() * dt);
+        stepIm = decay * std::sin(pendulum.getFrequency() * dt);
+        anchor();
+    }
+
+    // Position at the current sample
+    double value() const { return im; }
+    double time() const { return t0 + dt * index; }
+    std::size_t getIndex() const { return index; }
+
+    void step() {
+        index++;
+        if (index % reanchorInterval == 0) {
+            anchor();
+            return;
+        }
+        double nextRe = re * stepRe - im * stepIm;
+        im = re * stepIm + im * stepRe;
+        re = nextRe;
+    }
+
+    // Returns the current value and moves to the next sample
+    double next() {
+        double v = im;
+        step();
+        return v;
+    }
+
+    // Jump straight to sample i
+    void seek(std::size_t i) {
+        index = i;
+        anchor();
+    }
+};
+
+// Largest absolute difference between PendulumStepper and
+// Pendulum::calculate over count samples
+inline double stepperMaxError(const Pendulum& p, double t0, double dt, std::size_t count, std::size_t reanchorEvery = 1024) {
+    PendulumStepper stepper(p, t0, dt, reanchorEvery);
+    double maxError = 0.0;
+    for (std::size_t i = 0; i < count; i++) {
+        double error = std::fabs(stepper.next() - p.calculate(t0 + dt * i));
+        if (error > maxError) {
+            maxError = error;
+        }
+    }
+    return maxError;
+}
+
+struct HarmonographPoint{
+    double x;
+    double y;
+};
+
+// NX pendulums summed on the x axis and NY on the y axis, with the counts
+// fixed at compile time. Parameters live in plain arrays and the sums are
+// expanded with fold expressions, so for the usual 2+2 or 3+3 setups each
+// sample is a straight-line run of SIMD exp/sin kernels with no loop over
+// pendulums left. See PendulumBank for the runtime-sized equivalent.
+template <std::size_t NX, std::size_t NY>
+class Harmonograph{
+    private:
+    template <std::size_t N>
+    struct Axis {
+        std::array<double, N> amplitude{};
+        std::array<double, N> frequency{};
+        std::array<double, N> phase{};
+        std::array<double, N> damping{};
+
+        Axis() = default;
+        explicit Axis(const std::array<Pendulum, N>& pendulums) {
+            for (std::size_t i = 0; i < N; i++) {
+                amplitude[i] = pendulums[i].getAmplitude();
+                frequency[i] = pendulums[i].getFrequency();
+                phase[i] = pendulums[i].getPhase();
+                damping[i] = pendulums[i].getDamping();
+            }
+        }
+
+        template <std::size_t... I>
+        double sum(double t, std::index_sequence<I...>) const {
+            return (0.0 + ... + (amplitude[I] * std::exp(-damping[I] * t) * std::sin(frequency[I] * t + phase[I])));
+        }
+
+        template <typename Ops, std::size_t I>
+        typename Ops::vec term(typename Ops::vec t) const {
+            typename Ops::vec decay = simd::exp<Ops>(Ops::mul(Ops::set1(-damping[I]), t));
+            typename Ops::vec wave = simd::sin<Ops>(Ops::add(Ops::mul(Ops::set1(frequency[I]), t), Ops::set1(phase[I])));
+            return Ops::mul(Ops::mul(Ops::set1(amplitude[I]), decay), wave);
+        }
+
+        template <typename Ops, std::size_t... I>
+        typename Ops::vec sum(typename Ops::vec t, std::index_sequence<I...>) const {
+            typename Ops::vec acc = Ops::set1(0.0);
+            ((acc = Ops::add(acc, term<Ops, I>(t))), ...);
+            return acc;
+        }
+    };
+
+    Axis<NX> xAxis;
+    Axis<NY> yAxis;
+
+    template <typename Ops>
+    void evaluateBlock(double t0, double dt, std::size_t index, float* xs, float* ys) const {
+        typename Ops::vec idx = Ops::add(Ops::set1(static_cast<double>(index)), Ops::iota());
+        typename Ops::vec t = Ops::add(Ops::set1(t0), Ops::mul(Ops::set1(dt), idx));
+
+        double bx[Ops::width];
+        double by[Ops::width];
+        Ops::store(bx, xAxis.template sum<Ops>(t, std::make_index_sequence<NX>{}));
+        Ops::store(by, yAxis.template sum<Ops>(t, std::make_index_sequence<NY>{}));
+        for (std::size_t lane = 0; lane < Ops::width; lane++) {
+            xs[lane] = static_cast<float>(bx[lane]);
+            ys[lane] = static_cast<float>(by[lane]);
+        }
+    }
+
+    public:
+    Harmonograph() = default;
+    Harmonograph(const std::array<Pendulum, NX>& x, const std::array<Pendulum, NY>& y) : xAxis(x), yAxis(y) {}
+
+    static constexpr std::size_t sizeX() { return NX; }
+    static constexpr std::size_t sizeY() { return NY; }
+    static constexpr std::size_t blockWidth() { return simd::NativeOps::width; }
+
+    // Position at time t, same values as summing Pendulum::calculate
+    HarmonographPoint evaluate(double t) const {
+        return HarmonographPoint{xAxis.sum(t, std::make_index_sequence<NX>{}),
+                                 yAxis.sum(t, std::make_index_sequence<NY>{})};
+    }
+
+    // Samples [begin, end) of t = t0 + dt * i into xs/ys[0 .. end-begin)
+    void evaluateRange(double t0, double dt, std::size_t begin, std::size_t end, float* xs, float* ys) const {
+        constexpr std::size_t width = simd::NativeOps::width;
+        std::size_t i = begin;
+        for (; i + width <= end; i += width) {
+            evaluateBlock<simd::NativeOps>(t0, dt, i, xs + (i - begin), ys + (i - begin));
+        }
+        for (; i < end; i++) {
+            evaluateBlock<simd::ScalarOps>(t0, dt, i, xs + (i - begin), ys + (i - begin));
+        }
+    }
+
+    void evaluateRange(double t0, double dt, std::size_t n, float* xs, float* ys) const {
+        evaluateRange(t0, dt, 0, n, xs, ys);
+    }
 };
\ No newline at end of file
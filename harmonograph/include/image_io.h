@@ -0,0 +1,141 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef HARMONOGRAPH_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+// Binary PPM (P6), 8-bit interleaved RGB
+inline bool writePPM(const std::string& path, int width, int height, const std::vector<std::uint8_t>& rgb) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file << "P6\n" << width << " " << height << "\n255\n";
+    file.write(reinterpret_cast<const char*>(rgb.data()), rgb.size());
+    return static_cast<bool>(file);
+}
+
+namespace png_detail {
+
+inline std::uint32_t crc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0) {
+    static const std::vector<std::uint32_t> table = [] {
+        std::vector<std::uint32_t> t(256);
+        for (std::uint32_t n = 0; n < 256; n++) {
+            std::uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[n] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+inline void putU32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    out.push_back(static_cast<std::uint8_t>(v >> 24));
+    out.push_back(static_cast<std::uint8_t>(v >> 16));
+    out.push_back(static_cast<std::uint8_t>(v >> 8));
+    out.push_back(static_cast<std::uint8_t>(v));
+}
+
+inline void writeChunk(std::ofstream& file, const char* type, const std::vector<std::uint8_t>& payload) {
+    std::vector<std::uint8_t> chunk;
+    putU32(chunk, static_cast<std::uint32_t>(payload.size()));
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), payload.begin(), payload.end());
+    putU32(chunk, crc32(chunk.data() + 4, chunk.size() - 4));
+    file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+}
+
+// zlib stream of raw, uncompressed ("stored") deflate blocks, for builds
+// without zlib
+inline std::vector<std::uint8_t> storeDeflate(const std::vector<std::uint8_t>& raw) {
+    std::vector<std::uint8_t> out = {0x78, 0x01};
+    std::size_t pos = 0;
+    do {
+        std::size_t len = std::min<std::size_t>(raw.size() - pos, 65535);
+        bool last = pos + len == raw.size();
+        out.push_back(last ? 1 : 0);
+        out.push_back(static_cast<std::uint8_t>(len));
+        out.push_back(static_cast<std::uint8_t>(len >> 8));
+        out.push_back(static_cast<std::uint8_t>(~len));
+        out.push_back(static_cast<std::uint8_t>(~len >> 8));
+        out.insert(out.end(), raw.begin() + pos, raw.begin() + pos + len);
+        pos += len;
+    } while (pos < raw.size());
+
+    std::uint32_t a = 1;
+    std::uint32_t b = 0;
+    for (std::uint8_t byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    putU32(out, (b << 16) | a);
+    return out;
+}
+
+}  // namespace png_detail
+
+// 8-bit RGB PNG. Compressed with zlib when the build has it, otherwise
+// written with stored deflate blocks (valid, just larger).
+inline bool writePNG(const std::string& path, int width, int height, const std::vector<std::uint8_t>& rgb) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    // every scanline starts with filter type 0 (none)
+    std::size_t stride = static_cast<std::size_t>(width) * 3;
+    std::vector<std::uint8_t> raw;
+    raw.reserve((stride + 1) * height);
+    for (int y = 0; y < height; y++) {
+        raw.push_back(0);
+        raw.insert(raw.end(), rgb.begin() + y * stride, rgb.begin() + (y + 1) * stride);
+    }
+
+#ifdef HARMONOGRAPH_HAS_ZLIB
+    uLongf packedSize = compressBound(raw.size());
+    std::vector<std::uint8_t> idat(packedSize);
+    if (compress2(idat.data(), &packedSize, raw.data(), raw.size(), 6) != Z_OK) {
+        return false;
+    }
+    idat.resize(packedSize);
+#else
+    std::vector<std::uint8_t> idat = png_detail::storeDeflate(raw);
+#endif
+
+    static const std::uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    std::vector<std::uint8_t> header;
+    png_detail::putU32(header, static_cast<std::uint32_t>(width));
+    png_detail::putU32(header, static_cast<std::uint32_t>(height));
+    header.push_back(8);  // bit depth
+    header.push_back(2);  // color type: RGB
+    header.push_back(0);  // compression
+    header.push_back(0);  // filter
+    header.push_back(0);  // no interlace
+    png_detail::writeChunk(file, "IHDR", header);
+    png_detail::writeChunk(file, "IDAT", idat);
+    png_detail::writeChunk(file, "IEND", {});
+    return static_cast<bool>(file);
+}
+
+// Picks the format from the extension: .png, anything else is PPM
+inline bool writeImage(const std::string& path, int width, int height, const std::vector<std::uint8_t>& rgb) {
+    if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".png") == 0) {
+        return writePNG(path, width, height, rgb);
+    }
+    return writePPM(path, width, height, rgb);
+}
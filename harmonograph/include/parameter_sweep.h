@@ -0,0 +1,188 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "harmonograph.h"
+#include "pendulum_bank.h"
+
+// One point in parameter space: the pendulums of each axis
+struct PendulumSet{
+    std::vector<Pendulum> x;
+    std::vector<Pendulum> y;
+
+    static PendulumSet fromBank(const PendulumBank& bank) {
+        PendulumSet set;
+        for (std::size_t i = 0; i < bank.sizeX(); i++) {
+            set.x.push_back(bank.getX(i));
+        }
+        for (std::size_t i = 0; i < bank.sizeY(); i++) {
+            set.y.push_back(bank.getY(i));
+        }
+        return set;
+    }
+
+    PendulumBank bank() const {
+        PendulumBank b;
+        for (const Pendulum& p : x) {
+            b.addX(p);
+        }
+        for (const Pendulum& p : y) {
+            b.addY(p);
+        }
+        return b;
+    }
+
+    // Sets a parameter named like "x1.frequency" or "y2.damping" (fields
+    // may be shortened to a/f/p/d). Naming the pendulum right after the
+    // last one on an axis adds it. Returns false for unknown names.
+    bool set(const std::string& name, double value) {
+        std::size_t dot = name.find('.');
+        if (dot == std::string::npos || dot < 2 || (name[0] != 'x' && name[0] != 'y')) {
+            return false;
+        }
+        std::vector<Pendulum>& axis = name[0] == 'x' ? x : y;
+        long index = std::strtol(name.substr(1, dot - 1).c_str(), nullptr, 10) - 1;
+        if (index < 0 || index > static_cast<long>(axis.size())) {
+            return false;
+        }
+        if (index == static_cast<long>(axis.size())) {
+            axis.emplace_back();
+        }
+
+        Pendulum& p = axis[index];
+        std::string field = name.substr(dot + 1);
+        if (field == "amplitude" || field == "a") {
+            p.setAmplitude(value);
+        } else if (field == "frequency" || field == "f") {
+            p.setFrequency(value);
+        } else if (field == "phase" || field == "p") {
+            p.setPhase(value);
+        } else if (field == "damping" || field == "d") {
+            p.setDamping(value);
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    // Largest distance the curve can reach from its center on either axis
+    double extent() const {
+        double ex = 0.0;
+        double ey = 0.0;
+        for (const Pendulum& p : x) {
+            ex += std::fabs(p.getAmplitude());
+        }
+        for (const Pendulum& p : y) {
+            ey += std::fabs(p.getAmplitude());
+        }
+        return ex > ey ? ex : ey;
+    }
+};
+
+// A parameter varied over count evenly spaced values from first to last
+struct SweepRange{
+    std::string name;
+    double first;
+    double last;
+    std::size_t count;
+
+    double value(std::size_t i) const {
+        return count > 1 ? first + (last - first) * i / (count - 1) : first;
+    }
+};
+
+// Parses "x1.frequency=1:4:7,y1.phase=0:3.14:5" (name=first:last:count)
+inline bool parseSweepRanges(const std::string& spec, std::vector<SweepRange>& out, std::string& error) {
+    std::stringstream list(spec);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        std::size_t eq = item.find('=');
+        std::size_t c1 = item.find(':', eq);
+        std::size_t c2 = c1 == std::string::npos ? c1 : item.find(':', c1 + 1);
+        if (eq == std::string::npos || c2 == std::string::npos) {
+            error = "expected name=first:last:count, got '" + item + "'";
+            return false;
+        }
+        SweepRange range;
+        range.name = item.substr(0, eq);
+        range.first = std::strtod(item.substr(eq + 1, c1 - eq - 1).c_str(), nullptr);
+        range.last = std::strtod(item.substr(c1 + 1, c2 - c1 - 1).c_str(), nullptr);
+        long count = std::strtol(item.substr(c2 + 1).c_str(), nullptr, 10);
+        if (count < 1) {
+            error = "count must be at least 1 in '" + item + "'";
+            return false;
+        }
+        range.count = static_cast<std::size_t>(count);
+        out.push_back(range);
+    }
+    return true;
+}
+
+// Every combination of the ranges applied on top of base, the last range
+// varying fastest
+inline bool expandSweep(const PendulumSet& base, const std::vector<SweepRange>& ranges, std::vector<PendulumSet>& out, std::string& error) {
+    std::size_t total = 1;
+    for (const SweepRange& range : ranges) {
+        total *= range.count;
+    }
+    for (std::size_t n = 0; n < total; n++) {
+        PendulumSet set = base;
+        std::size_t rest = n;
+        for (std::size_t r = ranges.size(); r-- > 0;) {
+            if (!set.set(ranges[r].name, ranges[r].value(rest % ranges[r].count))) {
+                error = "unknown parameter '" + ranges[r].name + "'";
+                return false;
+            }
+            rest /= ranges[r].count;
+        }
+        out.push_back(set);
+    }
+    return true;
+}
+
+// Loads one parameter set per row from a CSV whose header names the
+// columns ("x1.frequency,y1.frequency,..."). Columns that a row leaves out
+// keep their value from base.
+inline bool loadSweepCsv(const std::string& path, const PendulumSet& base, std::vector<PendulumSet>& out, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "could not open " + path;
+        return false;
+    }
+
+    std::string line;
+    std::vector<std::string> columns;
+    if (std::getline(file, line)) {
+        std::stringstream header(line);
+        std::string name;
+        while (std::getline(header, name, ',')) {
+            columns.push_back(name);
+        }
+    }
+
+    std::size_t row = 1;
+    while (std::getline(file, line)) {
+        row++;
+        if (line.empty()) {
+            continue;
+        }
+        PendulumSet set = base;
+        std::stringstream fields(line);
+        std::string field;
+        for (std::size_t c = 0; c < columns.size() && std::getline(fields, field, ','); c++) {
+            if (field.empty()) {
+                continue;
+            }
+            if (!set.set(columns[c], std::strtod(field.c_str(), nullptr))) {
+                error = path + ":" + std::to_string(row) + ": unknown parameter '" + columns[c] + "'";
+                return false;
+            }
+        }
+        out.push_back(set);
+    }
+    return true;
+}
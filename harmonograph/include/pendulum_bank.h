@@ -0,0 +1,127 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "harmonograph.h"
+#include "simd_math.h"
+
+// Structure-of-arrays store for the X and Y pendulums of a harmonograph,
+// the runtime-sized counterpart of Harmonograph<NX, NY>. evaluateRange()
+// sums every pendulum of each axis over an evenly spaced time range, SIMD
+// lanes running along the time axis.
+class PendulumBank{
+    private:
+    struct Axis {
+        std::vector<double> amplitude;
+        std::vector<double> frequency;
+        std::vector<double> phase;
+        std::vector<double> damping;
+
+        void add(const Pendulum& p) {
+            amplitude.push_back(p.getAmplitude());
+            frequency.push_back(p.getFrequency());
+            phase.push_back(p.getPhase());
+            damping.push_back(p.getDamping());
+        }
+
+        std::size_t size() const { return amplitude.size(); }
+
+        void clear() {
+            amplitude.clear();
+            frequency.clear();
+            phase.clear();
+            damping.clear();
+        }
+
+        Pendulum get(std::size_t i) const {
+            return Pendulum(amplitude[i], frequency[i], phase[i], damping[i]);
+        }
+
+        double sum(double t) const {
+            double acc = 0.0;
+            for (std::size_t i = 0; i < amplitude.size(); i++) {
+                acc += amplitude[i] * std::exp(-damping[i] * t) * std::sin(frequency[i] * t + phase[i]);
+            }
+            return acc;
+        }
+
+        // sum over all pendulums of a * e^(-d*t) * sin(f*t + p)
+        template <typename Ops>
+        typename Ops::vec sum(typename Ops::vec t) const {
+            typename Ops::vec acc = Ops::set1(0.0);
+            for (std::size_t i = 0; i < amplitude.size(); i++) {
+                typename Ops::vec decay = simd::exp<Ops>(Ops::mul(Ops::set1(-damping[i]), t));
+                typename Ops::vec wave = simd::sin<Ops>(Ops::add(Ops::mul(Ops::set1(frequency[i]), t), Ops::set1(phase[i])));
+                acc = Ops::add(acc, Ops::mul(Ops::mul(Ops::set1(amplitude[i]), decay), wave));
+            }
+            return acc;
+        }
+    };
+
+    Axis xAxis;
+    Axis yAxis;
+
+    template <typename Ops>
+    void evaluateBlock(double t0, double dt, std::size_t index, float* xs, float* ys) const {
+        // t = t0 + dt * index, computed per sample so no error accumulates
+        typename Ops::vec idx = Ops::add(Ops::set1(static_cast<double>(index)), Ops::iota());
+        typename Ops::vec t = Ops::add(Ops::set1(t0), Ops::mul(Ops::set1(dt), idx));
+
+        double bx[Ops::width];
+        double by[Ops::width];
+        Ops::store(bx, xAxis.template sum<Ops>(t));
+        Ops::store(by, yAxis.template sum<Ops>(t));
+        for (std::size_t lane = 0; lane < Ops::width; lane++) {
+            xs[lane] = static_cast<float>(bx[lane]);
+            ys[lane] = static_cast<float>(by[lane]);
+        }
+    }
+
+    public:
+    PendulumBank() = default;
+
+    void addX(const Pendulum& p) { xAxis.add(p); }
+    void addY(const Pendulum& p) { yAxis.add(p); }
+    void clear() { xAxis.clear(); yAxis.clear(); }
+
+    std::size_t sizeX() const { return xAxis.size(); }
+    std::size_t sizeY() const { return yAxis.size(); }
+    Pendulum getX(std::size_t i) const { return xAxis.get(i); }
+    Pendulum getY(std::size_t i) const { return yAxis.get(i); }
+
+    // Number of samples handled per SIMD block
+    static constexpr std::size_t blockWidth() { return simd::NativeOps::width; }
+
+    // Position at time t, same values as summing Pendulum::calculate
+    HarmonographPoint evaluate(double t) const {
+        return HarmonographPoint{xAxis.sum(t), yAxis.sum(t)};
+    }
+
+    // Writes samples [begin, end) of the range t = t0 + dt * i into
+    // xs[0 .. end-begin) and ys[0 .. end-begin). Sample i gets the same value
+    // no matter which range it was requested in.
+    void evaluateRange(double t0, double dt, std::size_t begin, std::size_t end, float* xs, float* ys) const {
+        constexpr std::size_t width = simd::NativeOps::width;
+        std::size_t i = begin;
+        for (; i + width <= end; i += width) {
+            evaluateBlock<simd::NativeOps>(t0, dt, i, xs + (i - begin), ys + (i - begin));
+        }
+        for (; i < end; i++) {
+            evaluateBlock<simd::ScalarOps>(t0, dt, i, xs + (i - begin), ys + (i - begin));
+        }
+    }
+
+    void evaluateRange(double t0, double dt, std::size_t count, float* xs, float* ys) const {
+        evaluateRange(t0, dt, 0, count, xs, ys);
+    }
+};
+
+// The two-by-two pendulum setup the window has always drawn
+inline PendulumBank defaultBank() {
+    PendulumBank bank;
+    bank.addX(Pendulum(300, 2.0, 0.0, 0.002));
+    bank.addX(Pendulum(50, 5.0, 0.0, 0.002));
+    bank.addY(Pendulum(300, 3.0, M_PI/2, 0.002));
+    bank.addY(Pendulum(50, 7.0, 0.0, 0.002));
+    return bank;
+}
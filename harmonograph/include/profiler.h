@@ -0,0 +1,269 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Lightweight frame profiler. Scoped zones time sections of a frame; each
+// zone keeps a log-scale histogram of its per-frame cost, the last few
+// hundred frames are kept for an on-screen graph, and with event recording
+// on every zone instance can be exported as a Chrome trace
+// (chrome://tracing, Perfetto).
+//
+// When disabled a zone costs one branch. Defining HARMONOGRAPH_NO_PROFILING
+// removes HG_PROFILE_ZONE entirely.
+class FrameProfiler{
+    public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t kMaxZones = 8;
+    static constexpr std::size_t kHistoryFrames = 240;
+    // bucket b covers [2^b, 2^(b+1)) microseconds (bucket 0 starts at 0),
+    // split linearly into kSubBuckets, so a percentile is within about 3%
+    // of the true value however long the frames get
+    static constexpr std::size_t kBuckets = 24;
+    static constexpr std::size_t kSubBuckets = 16;
+
+    struct Histogram {
+        std::array<std::array<std::uint64_t, kSubBuckets>, kBuckets> counts{};
+        std::uint64_t total = 0;
+
+        static double bucketStart(std::size_t bucket) {
+            return bucket == 0 ? 0.0 : static_cast<double>(1ull << bucket);
+        }
+
+        static double subBucketWidth(std::size_t bucket) {
+            return (static_cast<double>(2ull << bucket) - bucketStart(bucket)) / kSubBuckets;
+        }
+
+        void add(double us) {
+            std::size_t bucket = 0;
+            while (bucket + 1 < kBuckets && us >= static_cast<double>(2ull << bucket)) {
+                bucket++;
+            }
+            double offset = (us - bucketStart(bucket)) / subBucketWidth(bucket);
+            std::size_t sub = offset > 0.0 ? static_cast<std::size_t>(offset) : 0;
+            counts[bucket][sub < kSubBuckets ? sub : kSubBuckets - 1]++;
+            total++;
+        }
+
+        // Midpoint, in milliseconds, of the sub-bucket holding quantile q
+        double percentileMs(double q) const {
+            if (total == 0) {
+                return 0.0;
+            }
+            std::uint64_t target = static_cast<std::uint64_t>(q * (total - 1)) + 1;
+            std::uint64_t seen = 0;
+            for (std::size_t b = 0; b < kBuckets; b++) {
+                for (std::size_t sub = 0; sub < kSubBuckets; sub++) {
+                    seen += counts[b][sub];
+                    if (seen >= target) {
+                        return (bucketStart(b) + (sub + 0.5) * subBucketWidth(b)) / 1000.0;
+                    }
+                }
+            }
+            return static_cast<double>(2ull << (kBuckets - 1)) / 1000.0;
+        }
+    };
+
+    struct Zone {
+        const char* name;
+        Histogram histogram;
+        double frameMs = 0.0;
+    };
+
+    // Per-zone milliseconds of one finished frame, plus the whole frame
+    struct FrameRecord {
+        std::array<float, kMaxZones> zoneMs{};
+        float totalMs = 0.0f;
+    };
+
+    private:
+    struct Event {
+        std::size_t zone;
+        Clock::time_point start;
+        Clock::time_point end;
+    };
+
+    bool enabled;
+    bool nextEnabled; // applied at the next beginFrame
+    bool recordEvents; // only when the events will be written out
+    std::size_t maxEvents;
+    std::vector<Zone> zoneList;
+    Zone frameZone{"frame", {}, 0.0};
+    std::vector<Event> events;
+    std::size_t droppedEvents = 0;
+    std::vector<FrameRecord> history;
+    std::size_t historyHead = 0;
+    Clock::time_point origin = Clock::now();
+    Clock::time_point frameStart;
+
+    std::size_t zoneIndex(const char* name) {
+        // zone names are string literals, so the pointer identifies them
+        for (std::size_t i = 0; i < zoneList.size(); i++) {
+            if (zoneList[i].name == name) {
+                return i;
+            }
+        }
+        if (zoneList.size() == kMaxZones) {
+            return kMaxZones;
+        }
+        zoneList.push_back(Zone{name, {}, 0.0});
+        return zoneList.size() - 1;
+    }
+
+    public:
+    // The event buffer is allocated up front when recording, so it never
+    // grows in the middle of a measured frame
+    explicit FrameProfiler(bool on = false, bool recordTrace = false, std::size_t eventCapacity = 1 << 20)
+        : enabled(on), nextEnabled(on), recordEvents(recordTrace), maxEvents(eventCapacity) {
+        history.resize(kHistoryFrames);
+        if (recordEvents) {
+            events.reserve(maxEvents);
+        }
+    }
+
+    bool isEnabled() const { return enabled; }
+
+    // Takes effect at the next beginFrame, so a frame is never measured
+    // from the middle or left without its end
+    void setEnabled(bool on) { nextEnabled = on; }
+
+    void beginFrame() {
+        enabled = nextEnabled;
+        if (!enabled) {
+            return;
+        }
+        frameStart = Clock::now();
+        for (Zone& zone : zoneList) {
+            zone.frameMs = 0.0;
+        }
+    }
+
+    void endFrame() {
+        if (!enabled) {
+            return;
+        }
+        Clock::time_point now = Clock::now();
+        double frameMs = std::chrono::duration<double, std::milli>(now - frameStart).count();
+        frameZone.histogram.add(frameMs * 1000.0);
+
+        FrameRecord& record = history[historyHead];
+        record = FrameRecord{};
+        record.totalMs = static_cast<float>(frameMs);
+        for (std::size_t i = 0; i < zoneList.size(); i++) {
+            zoneList[i].histogram.add(zoneList[i].frameMs * 1000.0);
+            record.zoneMs[i] = static_cast<float>(zoneList[i].frameMs);
+        }
+        historyHead = (historyHead + 1) % kHistoryFrames;
+
+        if (!recordEvents) {
+            return;
+        }
+        if (events.size() < maxEvents) {
+            events.push_back(Event{kMaxZones, frameStart, now});
+        } else {
+            droppedEvents++;
+        }
+    }
+
+    void record(const char* name, Clock::time_point start, Clock::time_point end) {
+        std::size_t index = zoneIndex(name);
+        if (index == kMaxZones) {
+            return;
+        }
+        zoneList[index].frameMs += std::chrono::duration<double, std::milli>(end - start).count();
+        if (!recordEvents) {
+            return;
+        }
+        if (events.size() < maxEvents) {
+            events.push_back(Event{index, start, end});
+        } else {
+            droppedEvents++;
+        }
+    }
+
+    const std::vector<Zone>& zones() const { return zoneList; }
+    const Zone& frame() const { return frameZone; }
+
+    // i = 0 is the oldest kept frame, kHistoryFrames - 1 the newest
+    const FrameRecord& historyAt(std::size_t i) const {
+        return history[(historyHead + i) % kHistoryFrames];
+    }
+
+    void printSummary(std::ostream& out) const {
+        out << std::fixed << std::setprecision(3);
+        out << "zone            p50 ms    p99 ms    frames\n";
+        auto row = [&](const Zone& zone) {
+            out << std::left << std::setw(14) << zone.name << std::right
+                << std::setw(8) << zone.histogram.percentileMs(0.5)
+                << std::setw(10) << zone.histogram.percentileMs(0.99)
+                << std::setw(10) << zone.histogram.total << "\n";
+        };
+        for (const Zone& zone : zoneList) {
+            row(zone);
+        }
+        row(frameZone);
+        if (droppedEvents > 0) {
+            out << droppedEvents << " trace events dropped (buffer full)\n";
+        }
+    }
+
+    // Chrome trace-event JSON with one complete ("X") event per zone run
+    bool writeChromeTrace(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) {
+            return false;
+        }
+        file << std::fixed << std::setprecision(3);
+        file << "{\"traceEvents\":[\n";
+        for (std::size_t i = 0; i < events.size(); i++) {
+            const Event& e = events[i];
+            const char* name = e.zone == kMaxZones ? frameZone.name : zoneList[e.zone].name;
+            double ts = std::chrono::duration<double, std::micro>(e.start - origin).count();
+            double dur = std::chrono::duration<double, std::micro>(e.end - e.start).count();
+            file << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << ts
+                 << ",\"dur\":" << dur << "}" << (i + 1 < events.size() ? ",\n" : "\n");
+        }
+        file << "],\"displayTimeUnit\":\"ms\"}\n";
+        return static_cast<bool>(file);
+    }
+};
+
+// Times the enclosing scope into a profiler zone
+class ScopedZone{
+    private:
+    FrameProfiler& profiler;
+    const char* name;
+    FrameProfiler::Clock::time_point start;
+    bool active;
+
+    public:
+    ScopedZone(FrameProfiler& p, const char* zoneName) : profiler(p), name(zoneName), active(p.isEnabled()) {
+        if (active) {
+            start = FrameProfiler::Clock::now();
+        }
+    }
+
+    ~ScopedZone() {
+        if (active) {
+            profiler.record(name, start, FrameProfiler::Clock::now());
+        }
+    }
+
+    ScopedZone(const ScopedZone&) = delete;
+    ScopedZone& operator=(const ScopedZone&) = delete;
+};
+
+#define HG_PROFILE_CONCAT_(a, b) a##b
+#define HG_PROFILE_CONCAT(a, b) HG_PROFILE_CONCAT_(a, b)
+#ifdef HARMONOGRAPH_NO_PROFILING
+#define HG_PROFILE_ZONE(profiler, name) ((void)0)
+#else
+#define HG_PROFILE_ZONE(profiler, name) ScopedZone HG_PROFILE_CONCAT(hgZone, __LINE__)(profiler, name)
+#endif
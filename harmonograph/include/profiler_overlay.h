@@ -0,0 +1,56 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include "profiler.h"
+
+// Draws the profiler's recent frames as stacked bars in the bottom-left
+// corner, one bar per frame and one color per zone, with a line at the
+// 60 FPS budget. Needs no font.
+inline void drawProfilerOverlay(sf::RenderTarget& target, const FrameProfiler& profiler, float pixelsPerMs = 4.0f) {
+    static const sf::Color zoneColors[FrameProfiler::kMaxZones] = {
+        sf::Color(230, 80, 80), sf::Color(80, 200, 90), sf::Color(80, 140, 240), sf::Color(240, 200, 60),
+        sf::Color(200, 90, 220), sf::Color(70, 210, 210), sf::Color(240, 140, 60), sf::Color(180, 180, 180),
+    };
+    const float barWidth = 2.0f;
+    const float bottom = static_cast<float>(target.getSize().y) - 10.0f;
+    const float left = 10.0f;
+
+    sf::VertexArray bars(sf::PrimitiveType::Triangles);
+    auto quad = [&](float x0, float y0, float x1, float y1, sf::Color color) {
+        bars.append(sf::Vertex{{x0, y0}, color});
+        bars.append(sf::Vertex{{x1, y0}, color});
+        bars.append(sf::Vertex{{x1, y1}, color});
+        bars.append(sf::Vertex{{x0, y0}, color});
+        bars.append(sf::Vertex{{x1, y1}, color});
+        bars.append(sf::Vertex{{x0, y1}, color});
+    };
+
+    // translucent backdrop
+    float width = FrameProfiler::kHistoryFrames * barWidth;
+    float height = 40.0f * pixelsPerMs;
+    quad(left - 4, bottom - height, left + width + 4, bottom + 4, sf::Color(0, 0, 0, 160));
+
+    std::size_t zoneCount = std::min(profiler.zones().size(), FrameProfiler::kMaxZones);
+    for (std::size_t f = 0; f < FrameProfiler::kHistoryFrames; f++) {
+        const FrameProfiler::FrameRecord& record = profiler.historyAt(f);
+        float x = left + f * barWidth;
+        float y = bottom;
+
+        // zones stacked bottom-up, the untimed rest of the frame in grey
+        float timed = 0.0f;
+        for (std::size_t z = 0; z < zoneCount; z++) {
+            float h = std::min(record.zoneMs[z] * pixelsPerMs, y - (bottom - height));
+            quad(x, y - h, x + barWidth, y, zoneColors[z]);
+            y -= h;
+            timed += record.zoneMs[z];
+        }
+        float rest = std::min(std::max(record.totalMs - timed, 0.0f) * pixelsPerMs, y - (bottom - height));
+        quad(x, y - rest, x + barWidth, y, sf::Color(90, 90, 90));
+    }
+
+    // 16.7 ms budget line
+    float budget = bottom - 1000.0f / 60.0f * pixelsPerMs;
+    quad(left, budget, left + width, budget + 1, sf::Color::White);
+
+    target.draw(bars);
+}
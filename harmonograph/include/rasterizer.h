@@ -0,0 +1,61 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "canvas.h"
+#include "curve.h"
+#include "thread_pool.h"
+
+// Default band height for tiled rasterization
+constexpr int kRasterTileHeight = 32;
+
+// Draws the points of curve as a line strip, the same way the window's
+// sf::LineStrip connects them. With a pool the canvas is cut into
+// horizontal bands of tileHeight rows; each band draws, in curve order,
+// only the segments that cross it, so bands never write to the same pixel
+// and the image matches the single-threaded one exactly.
+inline void rasterizeCurve(const CurveView& curve, Canvas& canvas, ThreadPool* pool = nullptr, int tileHeight = kRasterTileHeight) {
+    if (curve.size() < 2) {
+        return;
+    }
+    std::size_t segments = curve.size() - 1;
+
+    if (!pool || pool->size() == 1) {
+        for (std::size_t i = 0; i < segments; i++) {
+            canvas.drawLine(curve.x[i], curve.y[i], curve.x[i + 1], curve.y[i + 1], curve.color[i]);
+        }
+        return;
+    }
+
+    tileHeight = std::max(tileHeight, 1);
+    int tiles = (canvas.getHeight() + tileHeight - 1) / tileHeight;
+
+    // bin segment indices by the bands their rows touch, keeping curve order
+    std::vector<std::vector<std::uint32_t>> bins(tiles);
+    for (std::size_t i = 0; i < segments; i++) {
+        // Wu endpoints are snapped up to half a pixel along the line and
+        // cover one extra row, so pad the bounds before binning
+        float top = std::min(curve.y[i], curve.y[i + 1]) - 1.0f;
+        float bottom = std::max(curve.y[i], curve.y[i + 1]) + 2.0f;
+        if (bottom < 0.0f || top >= canvas.getHeight()) {
+            continue;
+        }
+        int first = std::max(static_cast<int>(std::floor(top)), 0) / tileHeight;
+        int last = std::min(static_cast<int>(std::floor(bottom)), canvas.getHeight() - 1) / tileHeight;
+        for (int tile = first; tile <= last; tile++) {
+            bins[tile].push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    pool->parallelFor(tiles, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t tile = begin; tile < end; tile++) {
+            int rowBegin = static_cast<int>(tile) * tileHeight;
+            int rowEnd = std::min(rowBegin + tileHeight, canvas.getHeight());
+            for (std::uint32_t i : bins[tile]) {
+                canvas.drawLine(curve.x[i], curve.y[i], curve.x[i + 1], curve.y[i + 1], curve.color[i], rowBegin, rowEnd);
+            }
+        }
+    });
+}
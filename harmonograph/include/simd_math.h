@@ -0,0 +1,232 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// Vectorized exp/sin kernels used by PendulumBank.
+//
+// Every backend runs the exact same algorithm (same constants, same order of
+// operations), only the register width changes. That way the scalar tail of a
+// batch produces the same values as the SIMD lanes would have.
+namespace simd {
+
+// Scalar fallback, also used for the tail of every batch
+struct ScalarOps {
+    using vec = double;
+    using ivec = std::int64_t;
+    static constexpr std::size_t width = 1;
+
+    static vec set1(double x) { return x; }
+    static vec iota() { return 0.0; }
+    static vec load(const double* p) { return *p; }
+    static void store(double* p, vec v) { *p = v; }
+
+    static vec add(vec a, vec b) { return a + b; }
+    static vec sub(vec a, vec b) { return a - b; }
+    static vec mul(vec a, vec b) { return a * b; }
+    static vec min(vec a, vec b) { return a < b ? a : b; }
+    static vec max(vec a, vec b) { return a > b ? a : b; }
+
+    static ivec toBits(vec v) { ivec i; std::memcpy(&i, &v, sizeof(i)); return i; }
+    static vec fromBits(ivec i) { vec v; std::memcpy(&v, &i, sizeof(v)); return v; }
+    static ivec iset1(std::int64_t x) { return x; }
+    static ivec iadd(ivec a, ivec b) { return static_cast<ivec>(static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b)); }
+    static ivec isub(ivec a, ivec b) { return static_cast<ivec>(static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b)); }
+    static ivec iand(ivec a, ivec b) { return a & b; }
+    static ivec iandnot(ivec mask, ivec b) { return ~mask & b; }
+    static ivec ior(ivec a, ivec b) { return a | b; }
+    static ivec ixor(ivec a, ivec b) { return a ^ b; }
+    static ivec shl52(ivec a) { return static_cast<ivec>(static_cast<std::uint64_t>(a) << 52); }
+    static ivec shl62(ivec a) { return static_cast<ivec>(static_cast<std::uint64_t>(a) << 62); }
+};
+
+#if defined(__AVX2__)
+struct Avx2Ops {
+    using vec = __m256d;
+    using ivec = __m256i;
+    static constexpr std::size_t width = 4;
+
+    static vec set1(double x) { return _mm256_set1_pd(x); }
+    static vec iota() { return _mm256_set_pd(3.0, 2.0, 1.0, 0.0); }
+    static vec load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, vec v) { _mm256_storeu_pd(p, v); }
+
+    static vec add(vec a, vec b) { return _mm256_add_pd(a, b); }
+    static vec sub(vec a, vec b) { return _mm256_sub_pd(a, b); }
+    static vec mul(vec a, vec b) { return _mm256_mul_pd(a, b); }
+    static vec min(vec a, vec b) { return _mm256_min_pd(a, b); }
+    static vec max(vec a, vec b) { return _mm256_max_pd(a, b); }
+
+    static ivec toBits(vec v) { return _mm256_castpd_si256(v); }
+    static vec fromBits(ivec i) { return _mm256_castsi256_pd(i); }
+    static ivec iset1(std::int64_t x) { return _mm256_set1_epi64x(x); }
+    static ivec iadd(ivec a, ivec b) { return _mm256_add_epi64(a, b); }
+    static ivec isub(ivec a, ivec b) { return _mm256_sub_epi64(a, b); }
+    static ivec iand(ivec a, ivec b) { return _mm256_and_si256(a, b); }
+    static ivec iandnot(ivec mask, ivec b) { return _mm256_andnot_si256(mask, b); }
+    static ivec ior(ivec a, ivec b) { return _mm256_or_si256(a, b); }
+    static ivec ixor(ivec a, ivec b) { return _mm256_xor_si256(a, b); }
+    static ivec shl52(ivec a) { return _mm256_slli_epi64(a, 52); }
+    static ivec shl62(ivec a) { return _mm256_slli_epi64(a, 62); }
+};
+using NativeOps = Avx2Ops;
+inline const char* backendName() { return "avx2"; }
+#elif defined(__SSE2__) || defined(_M_X64)
+struct Sse2Ops {
+    using vec = __m128d;
+    using ivec = __m128i;
+    static constexpr std::size_t width = 2;
+
+    static vec set1(double x) { return _mm_set1_pd(x); }
+    static vec iota() { return _mm_set_pd(1.0, 0.0); }
+    static vec load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, vec v) { _mm_storeu_pd(p, v); }
+
+    static vec add(vec a, vec b) { return _mm_add_pd(a, b); }
+    static vec sub(vec a, vec b) { return _mm_sub_pd(a, b); }
+    static vec mul(vec a, vec b) { return _mm_mul_pd(a, b); }
+    static vec min(vec a, vec b) { return _mm_min_pd(a, b); }
+    static vec max(vec a, vec b) { return _mm_max_pd(a, b); }
+
+    static ivec toBits(vec v) { return _mm_castpd_si128(v); }
+    static vec fromBits(ivec i) { return _mm_castsi128_pd(i); }
+    static ivec iset1(std::int64_t x) { return _mm_set1_epi64x(x); }
+    static ivec iadd(ivec a, ivec b) { return _mm_add_epi64(a, b); }
+    static ivec isub(ivec a, ivec b) { return _mm_sub_epi64(a, b); }
+    static ivec iand(ivec a, ivec b) { return _mm_and_si128(a, b); }
+    static ivec iandnot(ivec mask, ivec b) { return _mm_andnot_si128(mask, b); }
+    static ivec ior(ivec a, ivec b) { return _mm_or_si128(a, b); }
+    static ivec ixor(ivec a, ivec b) { return _mm_xor_si128(a, b); }
+    static ivec shl52(ivec a) { return _mm_slli_epi64(a, 52); }
+    static ivec shl62(ivec a) { return _mm_slli_epi64(a, 62); }
+};
+using NativeOps = Sse2Ops;
+inline const char* backendName() { return "sse2"; }
+#else
+using NativeOps = ScalarOps;
+inline const char* backendName() { return "scalar"; }
+#endif
+
+// Adding 1.5 * 2^52 rounds to the nearest integer and leaves that integer
+// in the low mantissa bits, so one add gives both the rounded double and
+// (after subtracting the magic's bit pattern) the integer itself
+constexpr double kRoundMagic = 6755399441055744.0;
+
+// e^x, relative error around 1e-15 for x in [-708, 708]
+template <typename Ops>
+inline typename Ops::vec exp(typename Ops::vec x) {
+    using vec = typename Ops::vec;
+    using ivec = typename Ops::ivec;
+
+    x = Ops::min(Ops::max(x, Ops::set1(-708.0)), Ops::set1(708.0));
+
+    // x = k*ln2 + r, |r| <= ln2/2
+    const vec magic = Ops::set1(kRoundMagic);
+    vec kr = Ops::add(Ops::mul(x, Ops::set1(1.4426950408889634)), magic);
+    ivec k = Ops::isub(Ops::toBits(kr), Ops::toBits(magic));
+    vec kd = Ops::sub(kr, magic);
+    vec r = Ops::sub(x, Ops::mul(kd, Ops::set1(6.93147180369123816490e-01)));
+    r = Ops::sub(r, Ops::mul(kd, Ops::set1(1.90821492927058770002e-10)));
+
+    // Taylor series to degree 12, Horner form
+    vec p = Ops::set1(1.0 / 479001600.0);
+    p = Ops::add(Ops::mul(p, r), Ops::set1(1.0 / 39916800.0));
+    p = Ops::add(Ops::mul(p, r), Ops::set1(1.0 / 3628800.0));
+    p = Ops::add(Ops::mul(p, r), Ops::set1(1.0 / 362880.0));
+    p = Ops::add(Ops::mul(p, r), Ops::set1(1.0 / 40320.0));
+    p = Ops::add(Ops::mul(p, r), Ops::set1(1.0 / 5040.0));
+    p = Ops::add(Ops::mul(p, r), Ops::set1(1.0 / 720.0));
+    p = Ops::add(Ops::mul(p, r), Ops::set1(1.0 / 120.0));
+    p = Ops::add(Ops::mul(p, r), Ops::set1(1.0 / 24.0));
+    p = Ops::add(Ops::mul(p, r), Ops::set1(1.0 / 6.0));
+    p = Ops::add(Ops::mul(p, r), Ops::set1(0.5));
+    p = Ops::add(Ops::mul(p, r), Ops::set1(1.0));
+    p = Ops::add(Ops::mul(p, r), Ops::set1(1.0));
+
+    // scale by 2^k by building the exponent field directly
+    vec scale = Ops::fromBits(Ops::shl52(Ops::iadd(k, Ops::iset1(1023))));
+    return Ops::mul(p, scale);
+}
+
+// Argument reduction and the two polynomials shared by sin and sincos
+template <typename Ops>
+struct SinCosParts {
+    typename Ops::ivec q; // quadrant
+    typename Ops::vec s;  // sin(r)
+    typename Ops::vec c;  // cos(r)
+};
+
+template <typename Ops>
+inline SinCosParts<Ops> sinCosParts(typename Ops::vec x) {
+    using vec = typename Ops::vec;
+    using ivec = typename Ops::ivec;
+
+    // x = q*(pi/2) + r, |r| <= pi/4
+    const vec magic = Ops::set1(kRoundMagic);
+    vec qr = Ops::add(Ops::mul(x, Ops::set1(6.36619772367581382433e-01)), magic);
+    ivec q = Ops::isub(Ops::toBits(qr), Ops::toBits(magic));
+    vec qd = Ops::sub(qr, magic);
+    vec r = Ops::sub(x, Ops::mul(qd, Ops::set1(1.57079632673412561417e+00)));
+    r = Ops::sub(r, Ops::mul(qd, Ops::set1(6.07710050630396597660e-11)));
+    r = Ops::sub(r, Ops::mul(qd, Ops::set1(2.02226624871116645580e-21)));
+
+    vec z = Ops::mul(r, r);
+
+    // sin(r) = r + r^3 * S(r^2)
+    vec s = Ops::set1(1.58969099521155010221e-10);
+    s = Ops::add(Ops::mul(s, z), Ops::set1(-2.50507602534068634195e-08));
+    s = Ops::add(Ops::mul(s, z), Ops::set1(2.75573137070700676789e-06));
+    s = Ops::add(Ops::mul(s, z), Ops::set1(-1.98412698298579493134e-04));
+    s = Ops::add(Ops::mul(s, z), Ops::set1(8.33333333332248946124e-03));
+    s = Ops::add(Ops::mul(s, z), Ops::set1(-1.66666666666666324348e-01));
+    s = Ops::add(r, Ops::mul(Ops::mul(s, z), r));
+
+    // cos(r) = 1 - r^2/2 + r^4 * C(r^2)
+    vec c = Ops::set1(-1.13596475577881948265e-11);
+    c = Ops::add(Ops::mul(c, z), Ops::set1(2.08757232129817482790e-09));
+    c = Ops::add(Ops::mul(c, z), Ops::set1(-2.75573143513906633035e-07));
+    c = Ops::add(Ops::mul(c, z), Ops::set1(2.48015872894767294178e-05));
+    c = Ops::add(Ops::mul(c, z), Ops::set1(-1.38888888888741095749e-03));
+    c = Ops::add(Ops::mul(c, z), Ops::set1(4.16666666666666019037e-02));
+    c = Ops::add(Ops::sub(Ops::set1(1.0), Ops::mul(z, Ops::set1(0.5))),
+                 Ops::mul(Ops::mul(z, z), c));
+
+    return SinCosParts<Ops>{q, s, c};
+}
+
+// sin(q*(pi/2) + r) from sin(r) and cos(r): odd quadrants use cos,
+// quadrants 2 and 3 flip the sign
+template <typename Ops>
+inline typename Ops::vec quadrantSin(typename Ops::ivec q, typename Ops::vec s, typename Ops::vec c) {
+    using ivec = typename Ops::ivec;
+    ivec useCos = Ops::isub(Ops::iset1(0), Ops::iand(q, Ops::iset1(1)));
+    ivec bits = Ops::ior(Ops::iand(useCos, Ops::toBits(c)),
+                         Ops::iandnot(useCos, Ops::toBits(s)));
+    ivec sign = Ops::shl62(Ops::iand(q, Ops::iset1(2)));
+    return Ops::fromBits(Ops::ixor(bits, sign));
+}
+
+// sin(x), accurate to a few ulp for |x| < ~1.6e6 (the range where the
+// three-part Cody-Waite reduction below stays exact)
+template <typename Ops>
+inline typename Ops::vec sin(typename Ops::vec x) {
+    SinCosParts<Ops> parts = sinCosParts<Ops>(x);
+    return quadrantSin<Ops>(parts.q, parts.s, parts.c);
+}
+
+// sin(x) and cos(x) from one argument reduction; cos(x) is sin one
+// quadrant further on
+template <typename Ops>
+inline void sincos(typename Ops::vec x, typename Ops::vec& sine, typename Ops::vec& cosine) {
+    SinCosParts<Ops> parts = sinCosParts<Ops>(x);
+    sine = quadrantSin<Ops>(parts.q, parts.s, parts.c);
+    cosine = quadrantSin<Ops>(Ops::iadd(parts.q, Ops::iset1(1)), parts.s, parts.c);
+}
+
+}  // namespace simd
@@ -0,0 +1,202 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool. Every worker owns a deque: it pushes and pops
+// its own tasks at the back (newest first, still warm in cache) and, when
+// that runs dry, steals the oldest task from the front of another worker's
+// deque. Uneven tasks therefore balance themselves without a central queue
+// every thread contends on.
+class ThreadPool{
+    private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> nextQueue{0};
+
+    // tasks submitted but not yet taken; guarded by sleepMutex for sleepers
+    std::atomic<long> pending{0};
+    std::mutex sleepMutex;
+    std::condition_variable available;
+    bool stopping = false;
+
+    // which pool and deque the current thread works for, if any
+    inline static thread_local const ThreadPool* currentPool = nullptr;
+    inline static thread_local std::size_t currentQueue = 0;
+
+    bool popOwn(std::size_t index, std::function<void()>& task) {
+        WorkQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(std::size_t index, std::function<void()>& task) {
+        WorkQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    // Takes a task from this thread's own deque, or steals one
+    bool take(std::function<void()>& task) {
+        std::size_t count = queues.size();
+        std::size_t start = 0;
+        if (currentPool == this) {
+            if (popOwn(currentQueue, task)) {
+                pending--;
+                return true;
+            }
+            start = currentQueue + 1;
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            if (steal((start + i) % count, task)) {
+                pending--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(std::size_t index) {
+        currentPool = this;
+        currentQueue = index;
+        while (true) {
+            std::function<void()> task;
+            if (take(task)) {
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            available.wait(lock, [this] { return stopping || pending.load() > 0; });
+            if (stopping && pending.load() <= 0) {
+                return;
+            }
+        }
+    }
+
+    public:
+    // threads is the total parallelism; the thread calling parallelFor
+    // counts as one of them, so threads - 1 workers are started
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency()) {
+        std::size_t count = threads > 1 ? threads - 1 : 0;
+        for (std::size_t i = 0; i < count; i++) {
+            queues.push_back(std::make_unique<WorkQueue>());
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const { return workers.size() + 1; }
+
+    // Queues a task. From a worker it goes on that worker's own deque,
+    // otherwise the deques are filled round-robin. Without workers the task
+    // runs right away on the calling thread.
+    void submit(std::function<void()> task) {
+        if (queues.empty()) {
+            task();
+            return;
+        }
+        std::size_t index = currentPool == this ? currentQueue : nextQueue++ % queues.size();
+        {
+            std::lock_guard<std::mutex> lock(queues[index]->mutex);
+            queues[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            pending++;
+        }
+        available.notify_one();
+    }
+
+    // Runs one queued task on the calling thread, if there is one
+    bool runPendingTask() {
+        std::function<void()> task;
+        if (!take(task)) {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+    // Calls fn(begin, end) for consecutive chunks of [0, count) and returns
+    // once every chunk is done. Each chunk is a task; the calling thread
+    // keeps running or stealing tasks while it waits, so nested calls from
+    // inside a task cannot deadlock the pool.
+    template <typename Fn>
+    void parallelFor(std::size_t count, std::size_t chunkSize, Fn&& fn) {
+        if (count == 0) {
+            return;
+        }
+        chunkSize = std::max<std::size_t>(chunkSize, 1);
+        std::size_t chunks = (count + chunkSize - 1) / chunkSize;
+        if (workers.empty() || chunks == 1) {
+            for (std::size_t begin = 0; begin < count; begin += chunkSize) {
+                fn(begin, std::min(begin + chunkSize, count));
+            }
+            return;
+        }
+
+        std::atomic<std::size_t> remaining{chunks};
+        std::mutex doneMutex;
+        std::condition_variable done;
+        for (std::size_t chunk = 0; chunk < chunks; chunk++) {
+            submit([&, chunk]() {
+                std::size_t begin = chunk * chunkSize;
+                fn(begin, std::min(begin + chunkSize, count));
+                std::lock_guard<std::mutex> lock(doneMutex);
+                if (--remaining == 0) {
+                    done.notify_all();
+                }
+            });
+        }
+
+        while (remaining.load() > 0) {
+            if (runPendingTask()) {
+                continue;
+            }
+            // nothing left to steal: the last chunks are running elsewhere
+            std::unique_lock<std::mutex> lock(doneMutex);
+            done.wait_for(lock, std::chrono::milliseconds(1), [&] { return remaining.load() == 0; });
+        }
+        // the last task may still hold doneMutex; wait for it to let go
+        // before the mutex goes out of scope
+        std::lock_guard<std::mutex> lock(doneMutex);
+    }
+};
@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/canvas.h"
+#include "../include/cli_args.h"
+#include "../include/curve_generator.h"
+#include "../include/harmonograph.h"
+#include "../include/pendulum_bank.h"
+#include "../include/rasterizer.h"
+#include "../include/simd_math.h"
+
+// Times each stage of the harmonograph pipeline and prints JSON, so runs
+// from different builds can be diffed.
+//
+//   HarmonographBench [--samples 10000,100000,1000000] [--threads 1,2,4]
+//                     [--repeat 5] [--output bench.json]
+
+namespace {
+
+struct Result {
+    std::string stage;
+    std::size_t samples;
+    std::size_t threads;
+    double minMs;
+    double medianMs;
+};
+
+std::vector<std::size_t> parseList(const std::string& text) {
+    std::vector<std::size_t> values;
+    std::stringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        long v = std::strtol(item.c_str(), nullptr, 10);
+        if (v > 0) {
+            values.push_back(static_cast<std::size_t>(v));
+        }
+    }
+    return values;
+}
+
+std::string joinList(const std::vector<std::size_t>& values) {
+    std::string text;
+    for (std::size_t v : values) {
+        text += (text.empty() ? "" : ",") + std::to_string(v);
+    }
+    return text;
+}
+
+// Runs body repeat times and keeps the fastest and median wall time. reset,
+// if given, runs untimed before each repeat.
+Result measure(const std::string& stage, std::size_t samples, std::size_t threads, int repeat, const std::function<void()>& body,
+               const std::function<void()>& reset = nullptr) {
+    std::vector<double> times;
+    for (int i = 0; i < repeat; i++) {
+        if (reset) {
+            reset();
+        }
+        auto start = std::chrono::steady_clock::now();
+        body();
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return Result{stage, samples, threads, times.front(), times[times.size() / 2]};
+}
+
+// keeps results observable so the optimizer can't drop the work
+volatile double sink;
+
+}  // namespace
+
+int main(int argc, char** argv){
+    CliArgs args(argc, argv);
+    std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::size_t> defaultThreads;
+    for (std::size_t t = 1; t < hardware; t *= 2) {
+        defaultThreads.push_back(t);
+    }
+    defaultThreads.push_back(hardware);
+
+    std::vector<std::size_t> sampleCounts = parseList(args.get("samples", "10000,100000,1000000"));
+    std::vector<std::size_t> threadCounts = parseList(args.get("threads", joinList(defaultThreads)));
+    int repeat = std::max(1, static_cast<int>(args.getInt("repeat", 5)));
+    if (sampleCounts.empty() || threadCounts.empty()) {
+        std::cerr << "--samples and --threads need at least one positive value\n";
+        return 1;
+    }
+
+    PendulumBank bank = defaultBank();
+    Harmonograph<2, 2> unrolled({bank.getX(0), bank.getX(1)}, {bank.getY(0), bank.getY(1)});
+    const double dt = 0.01;
+    std::vector<Result> results;
+
+    // built once, so the kernels time evaluation rather than copying the
+    // pendulums out of the bank
+    std::vector<Pendulum> xPendulums;
+    std::vector<Pendulum> yPendulums;
+    for (std::size_t p = 0; p < bank.sizeX(); p++) {
+        xPendulums.push_back(bank.getX(p));
+    }
+    for (std::size_t p = 0; p < bank.sizeY(); p++) {
+        yPendulums.push_back(bank.getY(p));
+    }
+    const Color background{30, 30, 30, 255};
+    Canvas canvas(800, 800, background);
+
+    for (std::size_t samples : sampleCounts) {
+        std::vector<float> xs(samples);
+        std::vector<float> ys(samples);
+
+        // single-threaded evaluation kernels
+        results.push_back(measure("pendulum_calculate", samples, 1, repeat, [&] {
+            double acc = 0.0;
+            for (std::size_t i = 0; i < samples; i++) {
+                double t = dt * i;
+                for (const Pendulum& pendulum : xPendulums) {
+                    acc += pendulum.calculate(t);
+                }
+                for (const Pendulum& pendulum : yPendulums) {
+                    acc += pendulum.calculate(t);
+                }
+            }
+            sink = acc;
+        }));
+        results.push_back(measure("pendulum_stepper", samples, 1, repeat, [&] {
+            std::vector<PendulumStepper> steppers;
+            for (const Pendulum& pendulum : xPendulums) {
+                steppers.emplace_back(pendulum, 0.0, dt);
+            }
+            for (const Pendulum& pendulum : yPendulums) {
+                steppers.emplace_back(pendulum, 0.0, dt);
+            }
+            double acc = 0.0;
+            for (std::size_t i = 0; i < samples; i++) {
+                for (PendulumStepper& stepper : steppers) {
+                    acc += stepper.next();
+                }
+            }
+            sink = acc;
+        }));
+        results.push_back(measure("bank_evaluate", samples, 1, repeat, [&] {
+            bank.evaluateRange(0.0, dt, samples, xs.data(), ys.data());
+            sink = xs[samples - 1];
+        }));
+        results.push_back(measure("unrolled_evaluate", samples, 1, repeat, [&] {
+            unrolled.evaluateRange(0.0, dt, samples, xs.data(), ys.data());
+            sink = xs[samples - 1];
+        }));
+        results.push_back(measure("color", samples, 1, repeat, [&] {
+            unsigned acc = 0;
+            for (std::size_t i = 0; i < samples; i++) {
+                acc += curveColor(dt * i).r;
+            }
+            sink = acc;
+        }));
+
+        // full pipeline stages across thread counts
+        CurveParams params;
+        params.dt = dt;
+        params.count = samples;
+        CurveBuffer curve;
+        for (std::size_t threads : threadCounts) {
+            ThreadPool pool(threads);
+            results.push_back(measure("curve_generation", samples, threads, repeat, [&] {
+                generateCurve(bank, params, curve, &pool);
+                sink = curve.x()[samples - 1];
+            }));
+            results.push_back(measure("rasterization", samples, threads, repeat, [&] {
+                rasterizeCurve(curve.view(), canvas, &pool);
+                sink = canvas.data()[0];
+            }, [&] { canvas.clear(background); }));
+        }
+    }
+
+    std::ostringstream json;
+    json.precision(6);
+    json << "{\n";
+    json << "  \"simd_backend\": \"" << simd::backendName() << "\",\n";
+    json << "  \"hardware_threads\": " << hardware << ",\n";
+    json << "  \"repeat\": " << repeat << ",\n";
+    json << "  \"stepper_max_error\": " << stepperMaxError(bank.getX(0), 0.0, dt, sampleCounts.back()) << ",\n";
+    json << "  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        double perSecond = r.minMs > 0 ? r.samples / (r.minMs / 1000.0) : 0.0;
+        json << "    {\"stage\": \"" << r.stage << "\", \"samples\": " << r.samples << ", \"threads\": " << r.threads
+             << ", \"min_ms\": " << r.minMs << ", \"median_ms\": " << r.medianMs
+             << ", \"samples_per_sec\": " << perSecond << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+
+    if (args.has("output")) {
+        std::ofstream file(args.get("output", ""));
+        file << json.str();
+        if (!file) {
+            std::cerr << "could not write " << args.get("output", "") << "\n";
+            return 1;
+        }
+    } else {
+        std::cout << json.str();
+    }
+    return 0;
+}
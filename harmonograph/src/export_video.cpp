@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/bounded_queue.h"
+#include "../include/canvas.h"
+#include "../include/cli_args.h"
+#include "../include/curve_stream.h"
+#include "../include/pendulum_bank.h"
+#include "../include/rasterizer.h"
+
+// Renders the drawing animation (pointsPerFrame new points per frame, as in
+// the window) headlessly to a Y4M video or a raw RGB24 frame stream.
+//
+//   HarmonographVideo --output curve.y4m [--fps 60] [--points-per-frame 100]
+//   HarmonographVideo --output - --format raw | ffmpeg -f rawvideo -pix_fmt rgb24 -s 800x800 -i - out.mp4
+//
+// Generation, rasterization, color conversion and writing each run on
+// their own thread, linked by bounded queues so they overlap without
+// buffering the whole video. Each frame only draws its new segments on top
+// of the previous frame.
+
+namespace {
+
+struct Frame {
+    std::vector<std::uint8_t> data;
+};
+
+// Limited-range (studio swing: Y in 16-235, chroma in 16-240) BT.601 4:2:0,
+// the range Y4M decoders assume. Each chroma sample averages a 2x2 block,
+// so it sits centered between its luma samples, which is the siting the
+// C420jpeg tag in the header declares.
+void rgbToYuv420(const std::vector<std::uint8_t>& rgb, int width, int height, std::vector<std::uint8_t>& out) {
+    int chromaWidth = (width + 1) / 2;
+    int chromaHeight = (height + 1) / 2;
+    out.resize(static_cast<std::size_t>(width) * height + 2 * static_cast<std::size_t>(chromaWidth) * chromaHeight);
+    std::uint8_t* yPlane = out.data();
+    std::uint8_t* uPlane = yPlane + static_cast<std::size_t>(width) * height;
+    std::uint8_t* vPlane = uPlane + static_cast<std::size_t>(chromaWidth) * chromaHeight;
+
+    auto clamp = [](float v) { return static_cast<std::uint8_t>(std::min(std::max(v + 0.5f, 0.0f), 255.0f)); };
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const std::uint8_t* p = &rgb[(static_cast<std::size_t>(y) * width + x) * 3];
+            yPlane[static_cast<std::size_t>(y) * width + x] = clamp(16.0f + (65.481f * p[0] + 128.553f * p[1] + 24.966f * p[2]) / 255.0f);
+        }
+    }
+    for (int cy = 0; cy < chromaHeight; cy++) {
+        for (int cx = 0; cx < chromaWidth; cx++) {
+            // average the (up to) 2x2 block this chroma sample covers
+            float r = 0, g = 0, b = 0;
+            int n = 0;
+            for (int dy = 0; dy < 2 && cy * 2 + dy < height; dy++) {
+                for (int dx = 0; dx < 2 && cx * 2 + dx < width; dx++) {
+                    const std::uint8_t* p = &rgb[((static_cast<std::size_t>(cy) * 2 + dy) * width + cx * 2 + dx) * 3];
+                    r += p[0];
+                    g += p[1];
+                    b += p[2];
+                    n++;
+                }
+            }
+            r /= n;
+            g /= n;
+            b /= n;
+            std::size_t i = static_cast<std::size_t>(cy) * chromaWidth + cx;
+            uPlane[i] = clamp(128.0f + (-37.797f * r - 74.203f * g + 112.0f * b) / 255.0f);
+            vPlane[i] = clamp(128.0f + (112.0f * r - 93.786f * g - 18.214f * b) / 255.0f);
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv){
+    CliArgs args(argc, argv);
+    if (args.has("help")) {
+        std::cout << "usage: HarmonographVideo [--output file.y4m|-] [--format y4m|raw] [--width W] [--height H]\n"
+                     "                         [--fps N] [--points-per-frame N] [--duration T] [--dt DT]\n"
+                     "                         [--queue N]\n";
+        return 0;
+    }
+
+    std::string output = args.get("output", "harmonograph.y4m");
+    std::string format = args.get("format", "y4m");
+    int width = static_cast<int>(args.getInt("width", 800));
+    int height = static_cast<int>(args.getInt("height", 800));
+    long fps = args.getInt("fps", 60);
+    long pointsPerFrame = args.getInt("points-per-frame", 100);
+    double duration = args.getDouble("duration", 1000);
+    double dt = args.getDouble("dt", 0.01);
+    std::size_t queueDepth = static_cast<std::size_t>(std::max(1L, args.getInt("queue", 8)));
+
+    if (width <= 0 || height <= 0 || fps <= 0 || pointsPerFrame <= 0 || duration <= 0 || dt <= 0) {
+        std::cerr << "size, fps, points-per-frame, duration and dt must be positive\n";
+        return 1;
+    }
+    if (format != "y4m" && format != "raw") {
+        std::cerr << "unknown format '" << format << "' (y4m or raw)\n";
+        return 1;
+    }
+
+    std::FILE* file = output == "-" ? stdout : std::fopen(output.c_str(), "wb");
+    if (!file) {
+        std::cerr << "could not open " << output << "\n";
+        return 1;
+    }
+
+    CurveParams params;
+    params.dt = dt;
+    params.count = CurveParams::samplesFor(duration, dt);
+    params.centerX = width / 2.0f;
+    params.centerY = height / 2.0f;
+
+    BoundedQueue<CurveBuffer> segments(queueDepth);
+    BoundedQueue<Frame> rendered(queueDepth);
+    BoundedQueue<Frame> encoded(queueDepth);
+    auto start = std::chrono::steady_clock::now();
+
+    // stage 1: the next pointsPerFrame points of the curve per frame
+    std::thread generator([&] {
+        CurveStream stream(defaultBank(), params, static_cast<std::size_t>(pointsPerFrame));
+        while (!stream.done()) {
+            CurveView points = stream.next(static_cast<std::size_t>(pointsPerFrame));
+            CurveBuffer chunk;
+            chunk.resize(points.size());
+            std::copy(points.x, points.x + points.size(), chunk.x());
+            std::copy(points.y, points.y + points.size(), chunk.y());
+            std::copy(points.color, points.color + points.size(), chunk.color());
+            if (!segments.push(std::move(chunk))) {
+                break;
+            }
+        }
+        segments.close();
+    });
+
+    // stage 2: draw each chunk on top of the previous frame, snapshot it
+    std::thread rasterizer([&] {
+        Canvas canvas(width, height);
+        CurveBuffer chunk;
+        while (segments.pop(chunk)) {
+            rasterizeCurve(chunk.view(), canvas);
+            if (!rendered.push(Frame{canvas.toRGB8()})) {
+                break;
+            }
+        }
+        rendered.close();
+    });
+
+    // stage 3: color conversion for Y4M
+    std::thread encoder([&] {
+        Frame frame;
+        std::vector<std::uint8_t> yuv;
+        while (rendered.pop(frame)) {
+            if (format == "y4m") {
+                rgbToYuv420(frame.data, width, height, yuv);
+                frame.data.swap(yuv);
+            }
+            if (!encoded.push(std::move(frame))) {
+                break;
+            }
+        }
+        encoded.close();
+    });
+
+    // stage 4: writing, on this thread
+    bool ok = true;
+    if (format == "y4m") {
+        ok = std::fprintf(file, "YUV4MPEG2 W%d H%d F%ld:1 Ip A1:1 C420jpeg\n", width, height, fps) > 0;
+    }
+    Frame frame;
+    std::size_t frames = 0;
+    while (ok && encoded.pop(frame)) {
+        if (format == "y4m") {
+            ok = std::fputs("FRAME\n", file) >= 0;
+        }
+        ok = ok && std::fwrite(frame.data.data(), 1, frame.data.size(), file) == frame.data.size();
+        frames++;
+    }
+
+    // on a write error, unblock the earlier stages so they can exit
+    segments.close();
+    rendered.close();
+    encoded.close();
+    generator.join();
+    rasterizer.join();
+    encoder.join();
+
+    ok = (file == stdout ? std::fflush(file) : std::fclose(file)) == 0 && ok;
+    if (!ok) {
+        std::cerr << "could not write " << output << "\n";
+        return 1;
+    }
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    std::cerr << "wrote " << frames << " frames to " << output << " (" << elapsed.count() << " ms)\n";
+    return 0;
+}
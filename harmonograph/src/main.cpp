@@ -1,74 +1,176 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
 #include "../include/harmonograph.h"
+#include "../include/cli_args.h"
+#include "../include/curve_regenerator.h"
+#include "../include/curve_stream.h"
+#include "../include/parameter_sweep.h"
+#include "../include/pendulum_bank.h"
+#include "../include/profiler.h"
+#include "../include/profiler_overlay.h"
+
+// Options:
+//   --profile        time each part of the frame, print a summary on exit
+//   --trace FILE     also write a Chrome trace of every frame to FILE
+//   --overlay        start with the frame-time graph shown (F1 toggles it)
+//
+// Live parameter controls:
+//   1-4              select pendulum X1, X2, Y1, Y2
+//   Up / Down        frequency +/- 0.01
+//   Left / Right     phase -/+ 0.05
+//   PageUp / PageDown  damping x1.25 / /1.25
+//   any other key    restart the drawing animation
+int main(int argc, char** argv){
+    CliArgs args(argc, argv);
+    std::string tracePath = args.get("trace", "");
+    bool showOverlay = args.has("overlay");
+    bool alwaysProfile = args.has("profile") || !tracePath.empty();
+    FrameProfiler profiler(alwaysProfile || showOverlay, !tracePath.empty());
 
-int main(){
     sf::RenderWindow window;
     window.create(sf::VideoMode({800, 800}), "Harmonograph");
     window.setFramerateLimit(60);
     window.setPosition(sf::Vector2i(100,100));
 
-    Pendulum pendulumX1(300, 2.0, 0.0, 0.002);
-    Pendulum pendulumX2(50, 5.0, 0.0, 0.002);
-    Pendulum pendulumY1(300, 3.0, M_PI/2, 0.002); 
-    Pendulum pendulumY2(50, 7.0, 0.0, 0.002);
-
-    // Generate all points in advance
-    std::vector<sf::Vertex> allPoints;
-    
-    for (double t = 0; t < 1000; t+=0.01)
-    {
-        double x = pendulumX1.calculate(t) + pendulumX2.calculate(t);
-        double y = pendulumY1.calculate(t) + pendulumY2.calculate(t);
-
-        float screenX = 400 + x;
-        float screenY = 400 + y;
-
-        // Create a color gradient based on time
-        float ratio = t / 100.0f;
-        sf::Color color(
-            128 + 127 * std::sin(ratio * 3),
-            128 + 127 * std::sin(ratio * 5 + 1),
-            128 + 127 * std::sin(ratio * 7 + 2),
-            255
-        );
-
-        sf::Vertex vertex;
-        vertex.position = sf::Vector2f(screenX, screenY);
-        vertex.color = color;
-        allPoints.push_back(vertex);
-    }
-    
-    sf::VertexArray curve(sf::PrimitiveType::LineStrip);
-    int currentPoint = 0;
-    
+    PendulumSet pendulums = PendulumSet::fromBank(defaultBank());
+    std::size_t selected = 0;
+
+    CurveParams params;
+    params.dt = 0.01;
+    params.count = CurveParams::samplesFor(1000, params.dt);
+
+    // Points are generated as they are drawn, nothing is precomputed
+    CurveStream stream(pendulums.bank(), params);
+    bool animating = true;
+
+    // Edited curves are regenerated off the render thread and swapped in
+    // whole once ready
+    CurveRegenerator regenerator;
+    CurveBuffer edited;
+
+    // The curve accumulates in a texture, so each frame only draws the new
+    // segments instead of the whole curve so far
+    const sf::Color background(30, 30, 30);
+    sf::RenderTexture canvas(window.getSize());
+    canvas.clear(background);
+    canvas.display();
+    sf::Sprite sprite(canvas.getTexture());
+
+    std::vector<sf::Vertex> segment;
+    auto drawPoints = [&](const CurveView& points) {
+        segment.resize(points.size());
+        for (std::size_t i = 0; i < points.size(); i++) {
+            const Color& color = points.color[i];
+            segment[i].position = sf::Vector2f(points.x[i], points.y[i]);
+            segment[i].color = sf::Color(color.r, color.g, color.b, color.a);
+        }
+        canvas.draw(segment.data(), segment.size(), sf::PrimitiveType::LineStrip);
+    };
+
+    // Applies a key to the selected pendulum; false if it isn't a control
+    auto editParameter = [&](sf::Keyboard::Key code) {
+        std::vector<Pendulum>& axis = selected < pendulums.x.size() ? pendulums.x : pendulums.y;
+        Pendulum& p = axis[selected < pendulums.x.size() ? selected : selected - pendulums.x.size()];
+        switch (code) {
+            case sf::Keyboard::Key::Up: p.setFrequency(p.getFrequency() + 0.01); break;
+            case sf::Keyboard::Key::Down: p.setFrequency(p.getFrequency() - 0.01); break;
+            case sf::Keyboard::Key::Right: p.setPhase(p.getPhase() + 0.05); break;
+            case sf::Keyboard::Key::Left: p.setPhase(p.getPhase() - 0.05); break;
+            case sf::Keyboard::Key::PageUp: p.setDamping(p.getDamping() * 1.25); break;
+            case sf::Keyboard::Key::PageDown: p.setDamping(p.getDamping() / 1.25); break;
+            default: return false;
+        }
+        window.setTitle("Harmonograph - " + std::string(selected < pendulums.x.size() ? "X" : "Y") +
+                        std::to_string(selected < pendulums.x.size() ? selected + 1 : selected - pendulums.x.size() + 1) +
+                        " f=" + std::to_string(p.getFrequency()) + " p=" + std::to_string(p.getPhase()) +
+                        " d=" + std::to_string(p.getDamping()));
+        return true;
+    };
+
     sf::Clock clock;
-    
+
     while(window.isOpen()){
-        while(std::optional event = window.pollEvent()){
-            if(event->is<sf::Event::Closed>()){
-                window.close();
-            }
-            
-            if(event->is<sf::Event::KeyPressed>()) {
-                curve.clear();
-                currentPoint = 0;
+        profiler.beginFrame();
+
+        {
+            HG_PROFILE_ZONE(profiler, "events");
+            while(std::optional event = window.pollEvent()){
+                if(event->is<sf::Event::Closed>()){
+                    window.close();
+                }
+
+                if(const auto* key = event->getIf<sf::Event::KeyPressed>()) {
+                    if (key->code == sf::Keyboard::Key::F1) {
+                        showOverlay = !showOverlay;
+                        profiler.setEnabled(alwaysProfile || showOverlay);
+                        continue;
+                    }
+                    if (key->code >= sf::Keyboard::Key::Num1 && key->code <= sf::Keyboard::Key::Num4) {
+                        std::size_t index = static_cast<std::size_t>(key->code) - static_cast<std::size_t>(sf::Keyboard::Key::Num1);
+                        if (index < pendulums.x.size() + pendulums.y.size()) {
+                            selected = index;
+                        }
+                        continue;
+                    }
+                    if (editParameter(key->code)) {
+                        regenerator.request(pendulums.bank(), params);
+                        continue;
+                    }
+                    stream.reset(pendulums.bank(), params);
+                    animating = true;
+                    canvas.clear(background);
+                    canvas.display();
+                }
             }
         }
-        
-        if (currentPoint < allPoints.size()) {
+
+        // a regenerated curve replaces the picture in one go
+        if (regenerator.poll(edited)) {
+            HG_PROFILE_ZONE(profiler, "swap");
+            animating = false;
+            canvas.clear(background);
+            drawPoints(edited.view());
+            canvas.display();
+        }
+
+        if (animating && !stream.done()) {
             int pointsPerFrame = 100;
-            
-            for (int i = 0; i < pointsPerFrame && currentPoint < allPoints.size(); i++) {
-                curve.append(allPoints[currentPoint]);
-                currentPoint++;
+
+            CurveView points;
+            {
+                HG_PROFILE_ZONE(profiler, "generate");
+                points = stream.next(pointsPerFrame);
+            }
+
+            HG_PROFILE_ZONE(profiler, "append");
+            drawPoints(points);
+            canvas.display();
+        }
+
+        {
+            HG_PROFILE_ZONE(profiler, "draw");
+            window.clear(background);
+            window.draw(sprite);
+            if (showOverlay) {
+                drawProfilerOverlay(window, profiler);
             }
         }
 
-        window.clear(sf::Color(30, 30, 30));
-        window.draw(curve);
-        window.display();
+        {
+            HG_PROFILE_ZONE(profiler, "display");
+            window.display();
+        }
+
+        profiler.endFrame();
     }
-    
+
+    if (profiler.isEnabled()) {
+        profiler.printSummary(std::cout);
+    }
+    if (!tracePath.empty() && !profiler.writeChromeTrace(tracePath)) {
+        std::cerr << "could not write " << tracePath << "\n";
+        return 1;
+    }
+
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,101 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include "../include/adaptive_sampler.h"
+#include "../include/canvas.h"
+#include "../include/cli_args.h"
+#include "../include/curve_cache.h"
+#include "../include/curve_generator.h"
+#include "../include/image_io.h"
+#include "../include/pendulum_bank.h"
+#include "../include/rasterizer.h"
+
+// Renders the harmonograph straight to an image file, no window needed.
+//
+//   HarmonographRender --output curve.png [--width 800] [--height 800]
+//                      [--duration 1000] [--dt 0.01] [--threads N]
+//                      [--tolerance PX] [--cache DIR]
+//
+// With --tolerance the curve is sampled adaptively (see AdaptiveSampler)
+// instead of every dt, which needs far fewer points for the same image.
+// With --cache, fixed-step curves are kept in DIR (see curve_cache.h) and
+// mapped back in on later runs instead of being generated again.
+int main(int argc, char** argv){
+    CliArgs args(argc, argv);
+    if (args.has("help")) {
+        std::cout << "usage: HarmonographRender --output <file.png|file.ppm> [--width W] [--height H]\n"
+                     "                          [--duration T] [--dt DT] [--threads N] [--tolerance PX]\n"
+                     "                          [--cache DIR]\n";
+        return 0;
+    }
+
+    std::string output = args.get("output", "harmonograph.png");
+    int width = static_cast<int>(args.getInt("width", 800));
+    int height = static_cast<int>(args.getInt("height", 800));
+    double duration = args.getDouble("duration", 1000);
+    long threads = args.getInt("threads", std::thread::hardware_concurrency());
+
+    if (width <= 0 || height <= 0 || duration <= 0) {
+        std::cerr << "width, height and duration must be positive\n";
+        return 1;
+    }
+
+    PendulumBank bank = defaultBank();
+
+    CurveParams params;
+    params.dt = args.getDouble("dt", 0.01);
+    if (params.dt <= 0) {
+        std::cerr << "dt must be positive\n";
+        return 1;
+    }
+    params.count = CurveParams::samplesFor(duration, params.dt);
+    params.centerX = width / 2.0f;
+    params.centerY = height / 2.0f;
+
+    ThreadPool pool(threads > 0 ? threads : 1);
+    auto start = std::chrono::steady_clock::now();
+
+    CurveBuffer curve;
+    MappedCurve cached;
+    CurveView points;
+    if (args.has("tolerance")) {
+        AdaptiveParams adaptive;
+        adaptive.duration = duration;
+        adaptive.tolerance = args.getDouble("tolerance", adaptive.tolerance);
+        if (!(adaptive.tolerance > 0)) {
+            std::cerr << "tolerance must be positive\n";
+            return 1;
+        }
+        adaptive.centerX = params.centerX;
+        adaptive.centerY = params.centerY;
+        AdaptiveSampler(bank).sample(adaptive, curve);
+        points = curve.view();
+    } else if (args.has("cache")) {
+        CurveCache cache(args.get("cache", "."));
+        if (cache.load(bank, params, cached)) {
+            points = cached.view();
+        } else {
+            generateCurve(bank, params, curve, &pool);
+            points = curve.view();
+            if (!cache.store(bank, params, points)) {
+                std::cerr << "could not write " << cache.pathFor(bank, params) << "\n";
+            }
+        }
+    } else {
+        generateCurve(bank, params, curve, &pool);
+        points = curve.view();
+    }
+
+    Canvas canvas(width, height);
+    rasterizeCurve(points, canvas, &pool);
+
+    if (!writeImage(output, width, height, canvas.toRGB8())) {
+        std::cerr << "could not write " << output << "\n";
+        return 1;
+    }
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    std::cout << "wrote " << output << " (" << points.size() << " points"
+              << (cached.isOpen() ? ", cached" : "") << ", " << elapsed.count() << " ms)\n";
+    return 0;
+}
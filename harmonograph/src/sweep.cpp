@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include "../include/canvas.h"
+#include "../include/cli_args.h"
+#include "../include/curve_generator.h"
+#include "../include/image_io.h"
+#include "../include/parameter_sweep.h"
+#include "../include/rasterizer.h"
+
+// Renders a grid of parameter sets into one contact sheet.
+//
+//   HarmonographSweep --vary x1.frequency=1:4:7,y1.frequency=2:5:7 --output sheet.png
+//   HarmonographSweep --csv sets.csv --output sheet.png
+//
+// Parameters not mentioned keep the values of the default curve. Every
+// thumbnail is one task on the work-stealing pool, and next to the atlas an
+// index CSV (<output>.csv) maps each tile back to its parameters.
+int main(int argc, char** argv){
+    CliArgs args(argc, argv);
+    if (args.has("help") || (!args.has("vary") && !args.has("csv"))) {
+        std::cout << "usage: HarmonographSweep (--vary name=first:last:count[,...] | --csv sets.csv)\n"
+                     "                         [--output sheet.png] [--thumb PX] [--columns N]\n"
+                     "                         [--duration T] [--dt DT] [--threads N]\n";
+        return args.has("help") ? 0 : 1;
+    }
+
+    std::string output = args.get("output", "sweep.png");
+    int thumb = static_cast<int>(args.getInt("thumb", 128));
+    double duration = args.getDouble("duration", 1000);
+    double dt = args.getDouble("dt", 0.05);
+    long threads = args.getInt("threads", std::thread::hardware_concurrency());
+    if (thumb <= 0 || duration <= 0 || dt <= 0) {
+        std::cerr << "thumb, duration and dt must be positive\n";
+        return 1;
+    }
+
+    PendulumSet base = PendulumSet::fromBank(defaultBank());
+    std::vector<PendulumSet> sets;
+    std::string error;
+    bool ok = args.has("csv") ? loadSweepCsv(args.get("csv", ""), base, sets, error) : true;
+    if (ok && args.has("vary")) {
+        std::vector<SweepRange> ranges;
+        ok = parseSweepRanges(args.get("vary", ""), ranges, error) && expandSweep(base, ranges, sets, error);
+    }
+    if (!ok) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+    if (sets.empty()) {
+        std::cerr << "no parameter sets to render\n";
+        return 1;
+    }
+
+    int columns = static_cast<int>(args.getInt("columns", static_cast<long>(std::ceil(std::sqrt(static_cast<double>(sets.size()))))));
+    columns = std::max(columns, 1);
+    int rows = static_cast<int>((sets.size() + columns - 1) / columns);
+    int atlasWidth = columns * thumb;
+    int atlasHeight = rows * thumb;
+    std::vector<std::uint8_t> atlas(static_cast<std::size_t>(atlasWidth) * atlasHeight * 3, 0);
+
+    ThreadPool pool(threads > 0 ? threads : 1);
+    auto start = std::chrono::steady_clock::now();
+
+    // one task per thumbnail; each tile owns a disjoint region of the atlas
+    pool.parallelFor(sets.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t n = begin; n < end; n++) {
+            const PendulumSet& set = sets[n];
+
+            CurveParams params;
+            params.dt = dt;
+            params.count = CurveParams::samplesFor(duration, dt);
+            params.centerX = thumb / 2.0f;
+            params.centerY = thumb / 2.0f;
+            double extent = set.extent();
+            params.scale = extent > 0 ? static_cast<float>(0.45 * thumb / extent) : 1.0f;
+
+            CurveBuffer curve;
+            generateCurve(set.bank(), params, curve);
+            Canvas canvas(thumb, thumb);
+            rasterizeCurve(curve.view(), canvas);
+            std::vector<std::uint8_t> pixels = canvas.toRGB8();
+
+            std::size_t column = n % columns;
+            std::size_t row = n / columns;
+            std::size_t stride = static_cast<std::size_t>(thumb) * 3;
+            for (int y = 0; y < thumb; y++) {
+                std::uint8_t* dst = &atlas[((row * thumb + y) * atlasWidth + column * thumb) * 3];
+                std::memcpy(dst, &pixels[y * stride], stride);
+            }
+        }
+    });
+
+    if (!writeImage(output, atlasWidth, atlasHeight, atlas)) {
+        std::cerr << "could not write " << output << "\n";
+        return 1;
+    }
+
+    // index: tile position plus every pendulum parameter of the set
+    std::size_t maxX = 0;
+    std::size_t maxY = 0;
+    for (const PendulumSet& set : sets) {
+        maxX = std::max(maxX, set.x.size());
+        maxY = std::max(maxY, set.y.size());
+    }
+    std::ofstream index(output + ".csv");
+    index.precision(10);
+    index << "tile,column,row";
+    for (std::size_t i = 1; i <= maxX; i++) {
+        index << ",x" << i << ".amplitude,x" << i << ".frequency,x" << i << ".phase,x" << i << ".damping";
+    }
+    for (std::size_t i = 1; i <= maxY; i++) {
+        index << ",y" << i << ".amplitude,y" << i << ".frequency,y" << i << ".phase,y" << i << ".damping";
+    }
+    index << "\n";
+    auto writeAxis = [&](const std::vector<Pendulum>& axis, std::size_t width) {
+        for (std::size_t i = 0; i < width; i++) {
+            if (i < axis.size()) {
+                index << "," << axis[i].getAmplitude() << "," << axis[i].getFrequency() << ","
+                      << axis[i].getPhase() << "," << axis[i].getDamping();
+            } else {
+                index << ",,,,";
+            }
+        }
+    };
+    for (std::size_t n = 0; n < sets.size(); n++) {
+        index << n << "," << n % columns << "," << n / columns;
+        writeAxis(sets[n].x, maxX);
+        writeAxis(sets[n].y, maxY);
+        index << "\n";
+    }
+    if (!index) {
+        std::cerr << "could not write " << output << ".csv\n";
+        return 1;
+    }
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    std::cout << "wrote " << output << " (" << sets.size() << " thumbnails, " << columns << "x" << rows
+              << ", " << elapsed.count() << " ms)\n";
+    return 0;
+}
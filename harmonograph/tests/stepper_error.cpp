@@ -0,0 +1,30 @@
+#include <iostream>
+#include "../include/harmonograph.h"
+#include "../include/pendulum_bank.h"
+
+// Checks PendulumStepper against Pendulum::calculate on the default
+// pendulums over a full 1000-unit curve at the default dt, and fails if
+// the recurrence drifts further than kMaxError (in pixels) from it.
+int main(){
+    const double kMaxError = 1e-9;
+    const double dt = 0.01;
+    const std::size_t count = 100000;
+
+    PendulumBank bank = defaultBank();
+    double worst = 0.0;
+    for (std::size_t i = 0; i < bank.sizeX() + bank.sizeY(); i++) {
+        Pendulum p = i < bank.sizeX() ? bank.getX(i) : bank.getY(i - bank.sizeX());
+        double error = stepperMaxError(p, 0.0, dt, count);
+        std::cout << "pendulum " << i << ": max error " << error << "\n";
+        if (error > worst) {
+            worst = error;
+        }
+    }
+
+    if (worst > kMaxError) {
+        std::cout << "FAIL: max error " << worst << " exceeds " << kMaxError << "\n";
+        return 1;
+    }
+    std::cout << "max error " << worst << " (bound " << kMaxError << ")\n";
+    return 0;
+}
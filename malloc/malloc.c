@@ -1,7 +1,11 @@
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/mman.h>
+#include <time.h>
 #include <unistd.h>
 
 // Alignment to 8 bytes
@@ -17,59 +21,226 @@ typedef struct block {
     size_t size;        // Size of the user data area (not including header)
     int is_free;        // 1 if free, 0 if allocated
     struct block *next; // Next free block (only used when is_free = 1)
+    struct block *prev; // Previous free block (only used when is_free = 1)
 } block_t;
 
-// Global variables
-static block_t *free_list_head = NULL; // Head of free list
+// Boundary tag after the user data of every block: the size again, with
+// the free flag in the low bit (sizes are multiples of ALIGNMENT, so it's
+// spare). It lets c_free find the block physically before it in O(1).
+typedef size_t footer_t;
+
+// Header plus footer, the cost of every block
+#define BLOCK_OVERHEAD (sizeof(block_t) + sizeof(footer_t))
+
+// Largest request whose block, fences and page rounding still fit in a
+// size_t; anything bigger would wrap the arithmetic in grow_heap
+#define MAX_REQUEST \
+    (SIZE_MAX - BLOCK_OVERHEAD - 2 * sizeof(block_t) - PAGE_SIZE)
+
+// Split a free block only if the remainder would hold at least this much
+#define MIN_BLOCK_SIZE ALIGNMENT
+
+/*
+ * Every mmap'd region is laid out as
+ *
+ *   [fence footer][header|data|footer][header|data|footer]...[fence header]
+ *
+ * The fences are marked allocated, so coalescing stops at the region's
+ * edges without any bounds checks. No two free blocks are ever adjacent.
+ */
+
+/*
+ * Free blocks are kept in segregated bins:
+ *
+ *   bins 0..63    exact sizes 8, 16, ..., 512 (SMALL_BIN_MAX)
+ *   bins 64..118  power-of-two ranges [2^k, 2^(k+1)) for k = 9, ..., 63
+ *
+ * A bitmap marks the non-empty bins, so the smallest bin that can serve
+ * a request is found with a find-first-set instead of a list walk.
+ */
+#define SMALL_BIN_MAX 512
+#define NUM_SMALL_BINS (SMALL_BIN_MAX / ALIGNMENT)
+#define NUM_BINS (NUM_SMALL_BINS + 64 - 9)
+#define BITMAP_WORDS ((NUM_BINS + 63) / 64)
+
+/*
+ * Each thread keeps a cache of small blocks (tcache), one singly linked
+ * list per exact size up to TCACHE_MAX_SIZE. Cached blocks stay marked
+ * allocated, so the central heap never coalesces them away. Most small
+ * mallocs and frees touch only the cache; the central heap's lock is
+ * taken once per TCACHE_BATCH blocks to refill or flush it.
+ *
+ * Blocks don't belong to the thread that allocated them: a block freed by
+ * another thread simply goes into that thread's cache, and from there back
+ * to the central heap, so cross-thread frees need no special handling.
+ */
+#define TCACHE_MAX_SIZE 256
+#define TCACHE_CLASSES (TCACHE_MAX_SIZE / ALIGNMENT)
+#define TCACHE_BATCH 16 // Blocks moved per refill or flush
+#define TCACHE_LIMIT 64 // Most blocks cached per size before flushing
+
+typedef struct {
+    block_t *head[TCACHE_CLASSES]; // Cached blocks, linked through next
+    int count[TCACHE_CLASSES];
+    int registered; // Flushed at thread exit once set
+} tcache_t;
+
+// Global variables, all guarded by heap_lock
+static block_t *bins[NUM_BINS];            // Head of each bin's free list
+static uint64_t bin_bitmap[BITMAP_WORDS]; // Bit set if the bin is non-empty
+static pthread_mutex_t heap_lock = PTHREAD_MUTEX_INITIALIZER;
+static unsigned long tcache_refills; // Batches moved to or from caches
+static unsigned long tcache_flushes;
+
+// This thread's cache
+static __thread tcache_t tcache;
+static pthread_key_t tcache_key; // Its destructor flushes exiting threads
+static pthread_once_t tcache_key_once = PTHREAD_ONCE_INIT;
 
 // Function declarations
 void *c_malloc(size_t size);
 void c_free(void *ptr);
+block_t *heap_malloc(size_t size);
+void heap_free(block_t *block);
+void tcache_flush_all(void);
 block_t *find_free_block(size_t size);
 block_t *grow_heap(size_t size);
+void split_block(block_t *block, size_t size);
+int bin_index(size_t size);
 void print_heap_status(void);
 
+// The footer of a block, right after its user data
+static footer_t *footer_of(block_t *block) {
+    return (footer_t *)((char *)block + sizeof(block_t) + block->size);
+}
+
+// Marks the block free or allocated in both its header and its footer
+static void set_free(block_t *block, int is_free) {
+    block->is_free = is_free;
+    *footer_of(block) = block->size | (size_t)is_free;
+}
+
+// The block physically after this one (may be the region's end fence)
+static block_t *next_block(block_t *block) {
+    return (block_t *)((char *)footer_of(block) + sizeof(footer_t));
+}
+
+// Whether the block physically before this one is free, from its footer
+static int prev_is_free(block_t *block) {
+    return (int)(*((footer_t *)block - 1) & 1);
+}
+
+// The block physically before this one; only valid if it isn't a fence
+static block_t *prev_block(block_t *block) {
+    size_t prev_size = *((footer_t *)block - 1) & ~(size_t)1;
+    return (block_t *)((char *)block - sizeof(footer_t) - prev_size -
+                       sizeof(block_t));
+}
+
+// The bin a free block of this (aligned) size belongs in
+int bin_index(size_t size) {
+    if (size <= SMALL_BIN_MAX) {
+        return (int)(size / ALIGNMENT) - 1;
+    }
+
+    // floor(log2(size)), at least 9 here
+    int log2 = 63 - __builtin_clzll((unsigned long long)size);
+    return NUM_SMALL_BINS + (log2 - 9);
+}
+
+// First non-empty bin at or after start, or -1
+static int find_nonempty_bin(int start) {
+    for (int word = start / 64; word < BITMAP_WORDS; word++) {
+        uint64_t bits = bin_bitmap[word];
+        if (word == start / 64) {
+            bits &= ~0ULL << (start % 64); // Skip bins below start
+        }
+        if (bits) {
+            return word * 64 + __builtin_ctzll(bits);
+        }
+    }
+    return -1;
+}
+
 // Find a free block that's big enough
 block_t *find_free_block(size_t size) {
-    block_t *current = free_list_head;
+    int bin = bin_index(size);
+
+    // Every block in an exact-size bin fits; in a range bin, try the head
+    if (bins[bin] && bins[bin]->size >= size) {
+        return bins[bin];
+    }
 
-    while (current != NULL) {
-        if (current->size >= size) {
-            return current; // Found a suitable block
+    // Every block in any bin above this one is bigger than size
+    int larger = find_nonempty_bin(bin + 1);
+    if (larger >= 0) {
+        return bins[larger];
+    }
+
+    // Only the rest of this size's own range bin is left
+    if (size > SMALL_BIN_MAX && bins[bin]) {
+        for (block_t *current = bins[bin]->next; current;
+             current = current->next) {
+            if (current->size >= size) {
+                return current; // Found a suitable block
+            }
         }
-        current = current->next;
     }
 
     return NULL; // No suitable block found
 }
 
-// Remove a block from the free list
+// Remove a block from its bin (O(1), the lists are doubly linked)
 void remove_from_free_list(block_t *block) {
-    if (free_list_head == block) {
-        free_list_head = block->next;
-        return;
+    if (block->prev) {
+        block->prev->next = block->next;
+    } else {
+        int bin = bin_index(block->size);
+        bins[bin] = block->next;
+        if (!block->next) {
+            bin_bitmap[bin / 64] &= ~(1ULL << (bin % 64));
+        }
     }
 
-    block_t *current = free_list_head;
-    while (current && current->next != block) {
-        current = current->next;
+    if (block->next) {
+        block->next->prev = block->prev;
     }
+}
 
-    if (current) {
-        current->next = block->next;
+// Add a block to the free list of its bin
+void add_to_free_list(block_t *block) {
+    set_free(block, 1);
+    int bin = bin_index(block->size);
+    block->prev = NULL;
+    block->next = bins[bin];
+    if (bins[bin]) {
+        bins[bin]->prev = block;
     }
+    bins[bin] = block;
+    bin_bitmap[bin / 64] |= 1ULL << (bin % 64);
 }
 
-// Add a block to the free list
-void add_to_free_list(block_t *block) {
-    block->is_free = 1;
-    block->next = free_list_head;
-    free_list_head = block;
+// Shrink a block (not on the free list) to size bytes, returning the rest
+// to the free list as a block of its own if it's big enough to be useful
+void split_block(block_t *block, size_t size) {
+    if (block->size < size + BLOCK_OVERHEAD + MIN_BLOCK_SIZE) {
+        return; // Remainder too small, hand out the whole block
+    }
+
+    size_t remaining = block->size - size - BLOCK_OVERHEAD;
+    block->size = size;
+    set_free(block, block->is_free);
+
+    // The block was free, so its neighbours aren't: no need to coalesce
+    block_t *remainder_block = next_block(block);
+    remainder_block->size = remaining;
+    add_to_free_list(remainder_block);
 }
 
 // Grow the heap by requesting more memory from OS using mmap
 block_t *grow_heap(size_t size) {
-    size_t total_size = sizeof(block_t) + size;
+    size_t total_size = sizeof(footer_t) + BLOCK_OVERHEAD + size +
+                        sizeof(block_t); // Fences at both ends
 
     // Round up to page size for efficiency
     size_t mmap_size = ALIGN_TO_PAGE(total_size);
@@ -85,53 +256,157 @@ block_t *grow_heap(size_t size) {
         return NULL; // mmap failed
     }
 
-    // Initialize the new block
-    block_t *new_block = (block_t *)new_memory;
-    new_block->size = size;
-    new_block->is_free = 0; // Will be marked as allocated
+    // Fences, marked allocated so nothing coalesces past them
+    *(footer_t *)new_memory = 0;
+    block_t *end_fence =
+        (block_t *)((char *)new_memory + mmap_size - sizeof(block_t));
+    end_fence->size = 0;
+    end_fence->is_free = 0;
+
+    // Initialize the new block to span the whole region
+    block_t *new_block = (block_t *)((char *)new_memory + sizeof(footer_t));
+    new_block->size = mmap_size - 2 * sizeof(footer_t) - 2 * sizeof(block_t);
+    set_free(new_block, 0); // Will be marked as allocated
     new_block->next = NULL;
+    new_block->prev = NULL;
+
+    // If we allocated more than needed, the remainder goes to the free list
+    split_block(new_block, size);
+
+    return new_block;
+}
+
+// Allocate from the central heap; the caller holds heap_lock
+block_t *heap_malloc(size_t size) {
+    // Try to find a free block
+    block_t *block = find_free_block(size);
+
+    if (block) {
+        // Found a free block, remove it from free list
+        remove_from_free_list(block);
+        set_free(block, 0);
+
+        // Give back whatever we don't need
+        split_block(block, size);
+        return block;
+    }
+
+    // No suitable free block found, grow heap
+    return grow_heap(size);
+}
 
-    // If we allocated more than needed, create a free block with the remainder
-    size_t remaining = mmap_size - total_size;
-    if (remaining >= sizeof(block_t) + ALIGNMENT) {
-        block_t *remainder_block = (block_t *)((char *)new_memory + total_size);
-        remainder_block->size = remaining - sizeof(block_t);
-        remainder_block->is_free = 1;
-        remainder_block->next = NULL;
+// Return a block to the central heap; the caller holds heap_lock
+void heap_free(block_t *block) {
+    // Merge with the block after it, if that one is free
+    block_t *next = next_block(block);
+    if (next->is_free) {
+        remove_from_free_list(next);
+        block->size += BLOCK_OVERHEAD + next->size;
+    }
 
-        // Add the remainder to free list
-        add_to_free_list(remainder_block);
+    // And with the block before it, found through its footer
+    if (prev_is_free(block)) {
+        block_t *prev = prev_block(block);
+        remove_from_free_list(prev);
+        prev->size += BLOCK_OVERHEAD + block->size;
+        block = prev;
     }
 
-    return new_block;
+    // Add it back to the free list
+    add_to_free_list(block);
+}
+
+// Move up to count blocks of one size from this thread's cache back to
+// the central heap
+static void tcache_flush(int index, int count) {
+    pthread_mutex_lock(&heap_lock);
+    tcache_flushes++;
+    while (count-- > 0 && tcache.head[index]) {
+        block_t *block = tcache.head[index];
+        tcache.head[index] = block->next;
+        tcache.count[index]--;
+        heap_free(block);
+    }
+    pthread_mutex_unlock(&heap_lock);
+}
+
+// Give every cached block back to the central heap
+void tcache_flush_all(void) {
+    for (int index = 0; index < TCACHE_CLASSES; index++) {
+        if (tcache.head[index]) {
+            tcache_flush(index, tcache.count[index]);
+        }
+    }
+}
+
+static void tcache_destructor(void *value) {
+    (void)value; // Still this thread's cache; TLS outlives key destructors
+    tcache_flush_all();
+}
+
+static void tcache_create_key(void) {
+    pthread_key_create(&tcache_key, tcache_destructor);
+}
+
+// Arrange for this thread's cache to be flushed when it exits
+static void tcache_register(void) {
+    pthread_once(&tcache_key_once, tcache_create_key);
+    pthread_setspecific(tcache_key, &tcache);
+    tcache.registered = 1;
+}
+
+// Fill this thread's cache with a batch of blocks for size; returns how
+// many it got
+static int tcache_refill(int index, size_t size) {
+    if (!tcache.registered) {
+        tcache_register();
+    }
+
+    int count = 0;
+    pthread_mutex_lock(&heap_lock);
+    tcache_refills++;
+    while (count < TCACHE_BATCH) {
+        block_t *block = heap_malloc(size);
+        if (!block) {
+            break; // Out of memory
+        }
+        block->next = tcache.head[index];
+        tcache.head[index] = block;
+        count++;
+    }
+    pthread_mutex_unlock(&heap_lock);
+    tcache.count[index] += count;
+    return count;
 }
 
 // Our malloc implementation
 void *c_malloc(size_t size) {
-    if (size == 0) {
-        return NULL;
+    if (size == 0 || size > MAX_REQUEST) {
+        return NULL; // Nothing to allocate, or more than could be mapped
     }
 
     // Align the size
     size = ALIGN(size);
 
-    // Try to find a free block
-    block_t *block = find_free_block(size);
-
-    if (block) {
-        // Found a free block, remove it from free list
-        remove_from_free_list(block);
-        block->is_free = 0;
+    // Small sizes come from this thread's cache, without locking
+    if (size <= TCACHE_MAX_SIZE) {
+        int index = (int)(size / ALIGNMENT) - 1;
+        assert(index >= 0); // MAX_REQUEST keeps ALIGN from wrapping to 0
+        if (!tcache.head[index] && tcache_refill(index, size) == 0) {
+            return NULL; // Out of memory
+        }
 
-        // TODO: Handle splitting large blocks (for now, just use the whole
-        // block)
+        block_t *block = tcache.head[index];
+        tcache.head[index] = block->next;
+        tcache.count[index]--;
 
         // Return pointer to user data (skip the header)
         return (char *)block + sizeof(block_t);
     }
 
-    // No suitable free block found, grow heap
-    block = grow_heap(size);
+    pthread_mutex_lock(&heap_lock);
+    block_t *block = heap_malloc(size);
+    pthread_mutex_unlock(&heap_lock);
     if (!block) {
         return NULL; // Out of memory
     }
@@ -149,33 +424,67 @@ void c_free(void *ptr) {
     // Find the block header (it's right before the user data)
     block_t *block = (block_t *)((char *)ptr - sizeof(block_t));
 
-    // Add it back to the free list
-    add_to_free_list(block);
+    // Small blocks go to this thread's cache, whichever thread allocated
+    // them. The block may be bigger than what was asked for, so cache it
+    // by its own size.
+    if (block->size <= TCACHE_MAX_SIZE) {
+        int index = (int)(block->size / ALIGNMENT) - 1;
+        assert(index >= 0); // Only fences have size 0
+        if (tcache.count[index] >= TCACHE_LIMIT) {
+            tcache_flush(index, TCACHE_BATCH);
+        }
+        if (!tcache.registered) {
+            tcache_register();
+        }
+        block->next = tcache.head[index];
+        tcache.head[index] = block;
+        tcache.count[index]++;
+        return;
+    }
 
-    // TODO: Implement coalescing later
+    pthread_mutex_lock(&heap_lock);
+    heap_free(block);
+    pthread_mutex_unlock(&heap_lock);
 }
 
 // Debug function to print heap status
 void print_heap_status(void) {
-    printf("Free List: ");
-    block_t *current = free_list_head;
-
-    if (!current) {
-        printf("(empty)\n");
-        return;
+    pthread_mutex_lock(&heap_lock);
+    printf("Free Bins:");
+    int bin = find_nonempty_bin(0);
+
+    if (bin < 0) {
+        printf(" (empty)\n");
+    } else {
+        printf("\n");
     }
-
-    int count = 0;
-    while (current) {
-        printf("[size=%zu] -> ", current->size);
-        current = current->next;
-        count++;
-        if (count > 10) { // Prevent infinite loops in debugging
-            printf("...");
-            break;
+    for (; bin >= 0; bin = find_nonempty_bin(bin + 1)) {
+        printf("   bin %d: ", bin);
+        block_t *current = bins[bin];
+        int count = 0;
+        while (current) {
+            printf("[size=%zu] -> ", current->size);
+            current = current->next;
+            count++;
+            if (count > 10) { // Prevent infinite loops in debugging
+                printf("...");
+                break;
+            }
         }
+        printf("NULL\n");
     }
-    printf("NULL\n");
+    pthread_mutex_unlock(&heap_lock);
+
+    printf("Thread Cache:");
+    int cached = 0;
+    for (int index = 0; index < TCACHE_CLASSES; index++) {
+        if (tcache.count[index] > 0) {
+            printf(" [size=%d x%d]", (index + 1) * ALIGNMENT,
+                   tcache.count[index]);
+            cached++;
+        }
+    }
+    printf(cached ? "\n" : " (empty)\n");
 }
 
 /*
@@ -188,6 +497,167 @@ void print_heap_status(void) {
  * 5. mmap allows us to return large chunks back to OS (with munmap)
  */
 
+/*
+ * Multithreaded benchmarks, each run on 1..BENCH_MAX_THREADS threads:
+ *
+ * churn     every thread keeps BENCH_LIVE blocks of random small sizes
+ *           alive and replaces one at random per step. The mix of sizes
+ *           barely changes, so this is the cache's best case.
+ * burst     every thread allocates BENCH_LIVE blocks, then frees them all,
+ *           over and over. That's far more than TCACHE_LIMIT per size, so
+ *           its cache keeps refilling from and flushing to the central heap.
+ * handoff   threads work in pairs: a producer allocates and a consumer
+ *           frees everything it gets, so every block is a cross-thread
+ *           free and every batch goes through the central heap.
+ */
+#define BENCH_MAX_THREADS 8
+#define BENCH_STEPS 4000000 // Per thread
+#define BENCH_LIVE 8192      // Blocks per churn thread, ~256 per size
+#define BENCH_RING 1024      // Handoff queue between a producer/consumer
+
+typedef struct {
+    void *slots[BENCH_RING];
+    unsigned long head; // Written by the producer
+    unsigned long tail; // Written by the consumer
+} bench_ring_t;
+
+typedef struct {
+    int id;
+    bench_ring_t *ring; // Handoff only
+} bench_arg_t;
+
+static unsigned bench_random(unsigned *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static size_t bench_size(unsigned *state) {
+    return 8 + bench_random(state) % (TCACHE_MAX_SIZE - 8);
+}
+
+static void *bench_churn(void *arg) {
+    bench_arg_t *bench = arg;
+    unsigned state = 2463534242u + (unsigned)bench->id;
+    void **live = calloc(BENCH_LIVE, sizeof(void *));
+    if (!live) {
+        return NULL;
+    }
+    for (int i = 0; i < BENCH_LIVE; i++) {
+        live[i] = c_malloc(bench_size(&state));
+    }
+    for (int step = 0; step < BENCH_STEPS; step++) {
+        unsigned slot = bench_random(&state) % BENCH_LIVE;
+        c_free(live[slot]);
+        live[slot] = c_malloc(bench_size(&state));
+    }
+    for (int i = 0; i < BENCH_LIVE; i++) {
+        c_free(live[i]);
+    }
+    free(live);
+    return NULL;
+}
+
+static void *bench_burst(void *arg) {
+    bench_arg_t *bench = arg;
+    unsigned state = 2463534242u + (unsigned)bench->id;
+    void **live = calloc(BENCH_LIVE, sizeof(void *));
+    if (!live) {
+        return NULL;
+    }
+    for (int round = 0; round < BENCH_STEPS / BENCH_LIVE; round++) {
+        for (int i = 0; i < BENCH_LIVE; i++) {
+            live[i] = c_malloc(bench_size(&state));
+        }
+        for (int i = 0; i < BENCH_LIVE; i++) {
+            c_free(live[i]);
+        }
+    }
+    free(live);
+    return NULL;
+}
+
+static void *bench_producer(void *arg) {
+    bench_arg_t *bench = arg;
+    bench_ring_t *ring = bench->ring;
+    unsigned state = 2463534242u + (unsigned)bench->id;
+    for (unsigned long i = 0; i < BENCH_STEPS; i++) {
+        void *block = c_malloc(bench_size(&state));
+        while (i - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) ==
+               BENCH_RING) {
+            sched_yield(); // Queue full
+        }
+        ring->slots[i % BENCH_RING] = block;
+        __atomic_store_n(&ring->head, i + 1, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+static void *bench_consumer(void *arg) {
+    bench_arg_t *bench = arg;
+    bench_ring_t *ring = bench->ring;
+    for (unsigned long i = 0; i < BENCH_STEPS; i++) {
+        while (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == i) {
+            sched_yield(); // Queue empty
+        }
+        c_free(ring->slots[i % BENCH_RING]);
+        __atomic_store_n(&ring->tail, i + 1, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+// Runs one benchmark on threads threads and prints its throughput and
+// how often the central heap was visited
+typedef enum { BENCH_CHURN, BENCH_BURST, BENCH_HANDOFF } bench_kind_t;
+
+static void run_benchmark(const char *name, bench_kind_t kind, int threads) {
+    int handoff = kind == BENCH_HANDOFF;
+    static bench_ring_t rings[BENCH_MAX_THREADS / 2];
+    bench_arg_t args[BENCH_MAX_THREADS];
+    pthread_t ids[BENCH_MAX_THREADS];
+
+    pthread_mutex_lock(&heap_lock);
+    unsigned long batches = tcache_refills + tcache_flushes;
+    pthread_mutex_unlock(&heap_lock);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int t = 0; t < threads; t++) {
+        args[t].id = t;
+        args[t].ring = &rings[t / 2];
+        if (handoff && t % 2 == 0) {
+            rings[t / 2].head = 0;
+            rings[t / 2].tail = 0;
+        }
+        void *(*body)(void *) = kind == BENCH_CHURN   ? bench_churn
+                                : kind == BENCH_BURST ? bench_burst
+                                : t % 2 == 0          ? bench_producer
+                                                      : bench_consumer;
+        pthread_create(&ids[t], NULL, body, &args[t]);
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_join(ids[t], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    pthread_mutex_lock(&heap_lock);
+    batches = tcache_refills + tcache_flushes - batches;
+    pthread_mutex_unlock(&heap_lock);
+
+    double seconds =
+        (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    // A free and a malloc per step, per thread or per handoff pair
+    double steps = kind == BENCH_BURST
+                       ? (double)(BENCH_STEPS / BENCH_LIVE * BENCH_LIVE)
+                       : (double)BENCH_STEPS;
+    double ops = 2.0 * (handoff ? threads / 2 : threads) * steps;
+    printf("   %-8s %d thread%s: %.3f s, %5.1f M ops/s, "
+           "%.1f heap batches per 1000 ops\n",
+           name, threads, threads == 1 ? " " : "s", seconds,
+           ops / seconds / 1e6, 1000.0 * batches / ops);
+}
+
 int main() {
     printf("Simple Malloc Implementation (using mmap)\n");
     printf("==========================================\n");
@@ -207,8 +677,8 @@ int main() {
     c_free(ptr1);
     print_heap_status();
 
-    printf("\n4. Allocating 15 bytes (should reuse freed space)...\n");
-    char *ptr3 = (char *)c_malloc(15);
+    printf("\n4. Allocating 20 bytes (should reuse the cached block)...\n");
+    char *ptr3 = (char *)c_malloc(20);
     printf("   Allocated at: %p\n", ptr3);
     print_heap_status();
 
@@ -217,6 +687,27 @@ int main() {
     printf("   Allocated at: %p\n", ptr4);
     print_heap_status();
 
+    printf("\n6. Freeing the rest and flushing the thread cache "
+           "(neighbours coalesce)...\n");
+    c_free(ptr2);
+    c_free(ptr3);
+    c_free(ptr4);
+    print_heap_status();
+    tcache_flush_all();
+    print_heap_status();
+
+    printf("\n7. Multithreaded benchmarks (%d steps per thread)...\n",
+           BENCH_STEPS);
+    for (int threads = 1; threads <= BENCH_MAX_THREADS; threads *= 2) {
+        run_benchmark("churn", BENCH_CHURN, threads);
+    }
+    for (int threads = 1; threads <= BENCH_MAX_THREADS; threads *= 2) {
+        run_benchmark("burst", BENCH_BURST, threads);
+    }
+    for (int threads = 2; threads <= BENCH_MAX_THREADS; threads *= 2) {
+        run_benchmark("handoff", BENCH_HANDOFF, threads);
+    }
+
     printf("\nNote: mmap allocates in 4KB pages, so you might see large "
            "remainder blocks!\n");
 
@@ -0,0 +1,175 @@
+#include "policy.h"
+#include <stdlib.h>
+
+#define NONE -1
+
+// Runnable processes sit in a pairing heap ordered by virtual runtime,
+// ties broken first come first served. Nodes are indices into
+// processes[] with the links kept in parallel arrays, so nothing is
+// allocated per insert.
+typedef struct {
+    Process *base;
+    long long *vruntime;
+    long long *order; // insertion sequence, for ties
+    int *child;       // first child
+    int *sibling;     // next sibling
+    int root;
+    int runnable; // in the heap or running
+    long long min_vruntime;
+    long long next_order;
+    int target_latency;
+    int min_granularity;
+} Cfs;
+
+static int cfs_less(const Cfs *cfs, int a, int b) {
+    if (cfs->vruntime[a] != cfs->vruntime[b])
+        return cfs->vruntime[a] < cfs->vruntime[b];
+    return cfs->order[a] < cfs->order[b];
+}
+
+// Both a and b are roots without siblings
+static int cfs_meld(Cfs *cfs, int a, int b) {
+    if (a == NONE)
+        return b;
+    if (b == NONE)
+        return a;
+    if (cfs_less(cfs, b, a)) {
+        int t = a;
+        a = b;
+        b = t;
+    }
+    cfs->sibling[b] = cfs->child[a];
+    cfs->child[a] = b;
+    return a;
+}
+
+// Standard two-pass merge of a sibling list, without recursion: the
+// first pass melds pairs left to right onto a stack threaded through the
+// sibling links, the second melds the stack back up right to left
+static int cfs_merge_pairs(Cfs *cfs, int first) {
+    int stack = NONE;
+    while (first != NONE) {
+        int a = first;
+        int b = cfs->sibling[a];
+        if (b == NONE) {
+            cfs->sibling[a] = stack;
+            stack = a;
+            break;
+        }
+        first = cfs->sibling[b];
+        cfs->sibling[a] = NONE;
+        cfs->sibling[b] = NONE;
+        int pair = cfs_meld(cfs, a, b);
+        cfs->sibling[pair] = stack;
+        stack = pair;
+    }
+
+    int result = NONE;
+    while (stack != NONE) {
+        int next = cfs->sibling[stack];
+        cfs->sibling[stack] = NONE;
+        result = cfs_meld(cfs, stack, result);
+        stack = next;
+    }
+    return result;
+}
+
+static void cfs_insert(Cfs *cfs, Process *process) {
+    int i = (int)(process - cfs->base);
+    cfs->order[i] = cfs->next_order++;
+    cfs->child[i] = NONE;
+    cfs->sibling[i] = NONE;
+    cfs->root = cfs_meld(cfs, cfs->root, i);
+}
+
+// New processes start at the current minimum so they neither starve the
+// others nor get starved by them
+static int cfs_on_arrival(Policy *policy, Process *process, int now) {
+    (void)now;
+    Cfs *cfs = policy->state;
+    cfs->vruntime[process - cfs->base] = cfs->min_vruntime;
+    cfs->runnable++;
+    cfs_insert(cfs, process);
+    return 0;
+}
+
+static Process *cfs_pick_next(Policy *policy, int now, int *slice) {
+    (void)now;
+    Cfs *cfs = policy->state;
+    if (cfs->root == NONE)
+        return NULL;
+
+    int i = cfs->root;
+    cfs->root = cfs_merge_pairs(cfs, cfs->child[i]);
+    cfs->child[i] = NONE;
+    if (cfs->vruntime[i] > cfs->min_vruntime) {
+        cfs->min_vruntime = cfs->vruntime[i];
+    }
+
+    *slice = cfs->target_latency / cfs->runnable;
+    if (*slice < cfs->min_granularity) {
+        *slice = cfs->min_granularity;
+    }
+    return &cfs->base[i];
+}
+
+static void cfs_on_tick(Policy *policy, Process *process, int ran, int now) {
+    (void)now;
+    Cfs *cfs = policy->state;
+    cfs->vruntime[process - cfs->base] += ran;
+    cfs_insert(cfs, process);
+}
+
+static void cfs_on_complete(Policy *policy, Process *process, int now) {
+    (void)process;
+    (void)now;
+    Cfs *cfs = policy->state;
+    cfs->runnable--;
+}
+
+static void cfs_destroy(Policy *policy) {
+    Cfs *cfs = policy->state;
+    free(cfs->vruntime);
+    free(cfs->order);
+    free(cfs->child);
+    free(cfs->sibling);
+    free(cfs);
+    free(policy);
+}
+
+Policy *create_cfs_policy(Process processes[], int n, int target_latency,
+                          int min_granularity) {
+    if (target_latency < 1 || min_granularity < 1)
+        return NULL;
+
+    Policy *policy = malloc(sizeof(Policy));
+    Cfs *cfs = calloc(1, sizeof(Cfs));
+    if (policy == NULL || cfs == NULL) {
+        free(policy);
+        free(cfs);
+        return NULL;
+    }
+
+    policy->name = "CFS";
+    policy->state = cfs;
+    policy->on_arrival = cfs_on_arrival;
+    policy->pick_next = cfs_pick_next;
+    policy->on_tick = cfs_on_tick;
+    policy->on_complete = cfs_on_complete;
+    policy->destroy = cfs_destroy;
+
+    cfs->base = processes;
+    cfs->root = NONE;
+    cfs->target_latency = target_latency;
+    cfs->min_granularity = min_granularity;
+    cfs->vruntime = malloc((size_t)n * sizeof(long long));
+    cfs->order = malloc((size_t)n * sizeof(long long));
+    cfs->child = malloc((size_t)n * sizeof(int));
+    cfs->sibling = malloc((size_t)n * sizeof(int));
+    if (cfs->vruntime == NULL || cfs->order == NULL || cfs->child == NULL ||
+        cfs->sibling == NULL) {
+        cfs_destroy(policy);
+        return NULL;
+    }
+    return policy;
+}
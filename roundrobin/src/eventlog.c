@@ -0,0 +1,108 @@
+#include "eventlog.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char event_log_magic[8] = {'R', 'R', 'E', 'V',
+                                        'L', 'O', 'G', '\0'};
+
+EventLog *event_log_create(const char *binary_path, LogLevel level,
+                           FILE *text) {
+    EventLog *log = malloc(sizeof(EventLog));
+    if (log == NULL)
+        return NULL;
+
+    log->count = 0;
+    log->failed = 0;
+    log->text = level == LOG_TEXT ? text : NULL;
+    log->binary = NULL;
+    if (binary_path != NULL) {
+        log->binary = fopen(binary_path, "wb");
+        if (log->binary == NULL) {
+            free(log);
+            return NULL;
+        }
+
+        EventLogHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, event_log_magic, sizeof(event_log_magic));
+        header.version = EVENT_LOG_VERSION;
+        header.record_size = sizeof(EventRecord);
+        if (fwrite(&header, sizeof(header), 1, log->binary) != 1) {
+            log->failed = 1;
+        }
+    }
+    return log;
+}
+
+void event_log_flush(EventLog *log) {
+    if (log->binary != NULL &&
+        fwrite(log->records, sizeof(EventRecord), (size_t)log->count,
+               log->binary) != (size_t)log->count) {
+        log->failed = 1;
+    }
+    if (log->text != NULL) {
+        for (int i = 0; i < log->count; i++) {
+            format_event(log->text, &log->records[i]);
+        }
+    }
+    log->count = 0;
+}
+
+int event_log_destroy(EventLog *log) {
+    if (log == NULL)
+        return 0;
+
+    event_log_flush(log);
+    if (log->binary != NULL && fclose(log->binary) != 0) {
+        log->failed = 1;
+    }
+    int status = log->failed ? -1 : 0;
+    free(log);
+    return status;
+}
+
+void format_event(FILE *file, const EventRecord *record) {
+    switch (record->type) {
+    case EVENT_ARRIVE:
+        fprintf(file, "Time %d: Process P%d arrives\n", record->time,
+                record->pid);
+        break;
+    case EVENT_ARRIVE_DURING:
+        fprintf(file, "Time %d: Process P%d arrives during execution\n",
+                record->time, record->pid);
+        break;
+    case EVENT_RUN:
+        fprintf(file, "Time %d-%d: Process P%d executes for %d units\n",
+                record->time, record->time + record->length, record->pid,
+                record->length);
+        break;
+    case EVENT_COMPLETE:
+        fprintf(file, "Time %d: Process P%d completed\n", record->time,
+                record->pid);
+        break;
+    case EVENT_IDLE:
+        fprintf(file, "Time %d-%d: CPU idle\n", record->time,
+                record->time + record->length);
+        break;
+    }
+}
+
+FILE *event_log_open_read(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "could not open %s\n", path);
+        return NULL;
+    }
+
+    EventLogHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, event_log_magic, sizeof(event_log_magic)) != 0 ||
+        header.version != EVENT_LOG_VERSION ||
+        header.record_size != sizeof(EventRecord)) {
+        fprintf(stderr, "%s is not a version %d event log\n", path,
+                EVENT_LOG_VERSION);
+        fclose(file);
+        return NULL;
+    }
+    return file;
+}
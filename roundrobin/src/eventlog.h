@@ -0,0 +1,83 @@
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum {
+    EVENT_ARRIVE,        // process admitted at time
+    EVENT_ARRIVE_DURING, // arrived while another process ran, admitted
+                         // when its slice ended at time
+    EVENT_RUN,           // process ran from time for length units
+    EVENT_COMPLETE,      // process finished at time
+    EVENT_IDLE,          // CPU idle from time for length units
+} EventType;
+
+// Fixed-size binary record; the log file is a header and these, in order
+typedef struct {
+    int32_t time;
+    int32_t pid;
+    int32_t length;
+    int32_t type; // EventType
+} EventRecord;
+
+typedef struct {
+    char magic[8]; // "RREVLOG\0"
+    uint32_t version;
+    uint32_t record_size;
+} EventLogHeader;
+
+#define EVENT_LOG_VERSION 1
+#define EVENT_LOG_BUFFER 4096
+
+typedef enum {
+    LOG_QUIET, // no text
+    LOG_TEXT,  // every event as a line of text, as the scheduler always
+               // printed them
+} LogLevel;
+
+// Event sink for the simulator. Recording an event only copies a record
+// into a buffer; when it fills, the batch is appended to the binary log
+// and, at LOG_TEXT, formatted to the text stream. So the simulation loop
+// itself never formats anything, and with LOG_QUIET and no file the
+// records are simply dropped.
+typedef struct EventLog {
+    EventRecord records[EVENT_LOG_BUFFER];
+    int count;
+    FILE *binary; // NULL for no binary log
+    FILE *text;   // NULL unless LOG_TEXT
+    int failed;
+} EventLog;
+
+// binary_path may be NULL; text is used only at LOG_TEXT. Returns NULL
+// if the log can't be allocated or the file can't be created.
+EventLog *event_log_create(const char *binary_path, LogLevel level,
+                           FILE *text);
+
+// Flushes and closes; returns 0, or -1 if any write failed
+int event_log_destroy(EventLog *log);
+
+void event_log_flush(EventLog *log);
+
+static inline void event_log_record(EventLog *log, EventType type, int time,
+                                    int pid, int length) {
+    if (log == NULL)
+        return;
+    EventRecord *record = &log->records[log->count++];
+    record->time = time;
+    record->pid = pid;
+    record->length = length;
+    record->type = type;
+    if (log->count == EVENT_LOG_BUFFER) {
+        event_log_flush(log);
+    }
+}
+
+// Writes the record as the line the scheduler prints for it
+void format_event(FILE *file, const EventRecord *record);
+
+// Opens a binary log for reading, checking its header. Returns NULL with
+// a message on stderr if it isn't one.
+FILE *event_log_open_read(const char *path);
+
+#endif
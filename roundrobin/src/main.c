@@ -1,74 +1,456 @@
+#include "eventlog.h"
+#include "metrics.h"
+#include "multicore.h"
+#include "policy.h"
+#include "realtime.h"
 #include "scheduler.h"
+#include "sweep.h"
+#include "trace.h"
+#include "workload.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
-#include <unistd.h>
 
-#define n 10
+#define DEFAULT_PROCESS_COUNT 10
 
-int getRandom(ssize_t limit) {
+// Seed for runs that don't give one; printed so they can be repeated
+uint64_t random_seed(void) {
+    uint64_t seed = (uint64_t)time(NULL);
     FILE *random = fopen("/dev/urandom", "rb");
-    unsigned int seed;
 
     if (random) {
-        fread(&seed, sizeof(seed), 1, random);
+        if (fread(&seed, sizeof(seed), 1, random) != 1) {
+            seed = (uint64_t)time(NULL);
+        }
         fclose(random);
-        srand(seed);
-    } else {
-        srand(1);
     }
+    return seed;
+}
 
-    return rand() % limit;
+void print_multicore_summary(const MulticoreConfig *config,
+                             const CoreStats stats[], int makespan) {
+    long long migrations = 0;
+    printf("\n=== Cores (makespan %d) ===\n", makespan);
+    printf("Core\tBusy\tUtil%%\tSlices\tDone\tMigIn\tMigOut\n");
+    for (int i = 0; i < config->cores; i++) {
+        double utilization =
+            makespan > 0 ? 100.0 * stats[i].busy_time / makespan : 0.0;
+        printf("%d\t%lld\t%.1f\t%lld\t%lld\t%lld\t%lld\n", i,
+               stats[i].busy_time, utilization, stats[i].slices,
+               stats[i].completed, stats[i].migrations_in,
+               stats[i].migrations_out);
+        migrations += stats[i].migrations_in;
+    }
+    printf("Total migrations: %lld\n", migrations);
 }
 
-int compare_arrival_time(const void *a, const void *b) {
-    Process *processA = (Process *)a;
-    Process *processB = (Process *)b;
+// Runs a copy of the workload under every policy and prints one row each
+int compare_policies(const Process processes[], int n, int time_quantum) {
+    Process *copy = malloc((size_t)n * sizeof(Process));
+    if (copy == NULL)
+        return -1;
+
+    printf("\n=== Policy Comparison (Time Quantum: %d) ===\n", time_quantum);
+    printf("Policy\tMeanTAT\tP99TAT\tMeanWait\tP99Wait\tMeanResp\tP99Resp"
+           "\tSwitches\tMakespan\n");
+    for (int p = 0; p < 3; p++) {
+        memcpy(copy, processes, (size_t)n * sizeof(Process));
+        Policy *policy =
+            p == 0   ? create_rr_policy(copy, n, time_quantum)
+            : p == 1 ? create_mlfq_policy(copy, n, 3, time_quantum,
+                                          50 * time_quantum)
+                     : create_cfs_policy(copy, n, 8 * time_quantum, 1);
+        if (policy == NULL) {
+            free(copy);
+            return -1;
+        }
 
-    return processA->arrival_time - processB->arrival_time;
+        SimulationStats stats;
+        Metrics metrics;
+        simulate(copy, n, policy, NULL, &stats);
+        if (compute_metrics(copy, n, &metrics) != 0) {
+            destroy_policy(policy);
+            free(copy);
+            return -1;
+        }
+        printf("%s\t%.2f\t%d\t%.2f\t\t%d\t%.2f\t\t%d\t%lld\t\t%d\n",
+               policy->name, metrics.mean_turnaround, metrics.p99_turnaround,
+               metrics.mean_waiting, metrics.p99_waiting,
+               metrics.mean_response, metrics.p99_response,
+               stats.context_switches, stats.makespan);
+        destroy_policy(policy);
+    }
+    free(copy);
+    return 0;
 }
 
-int main() {
+// Frees the process array, if there is one, and unmaps the trace, if any
+void release_processes(Process *processes, Trace *trace) {
+    free(processes);
+    trace_close(trace);
+}
 
-    Process processes[n];
-    int time_quantum = 3;
+void add_to_metrics(void *context, const Process *process) {
+    metrics_stream_add(context, process);
+}
 
-    for (int i = 0; i < n; i++) {
-        processes[i].pid = i;
-        processes[i].arrival_time = getRandom(31);
-        processes[i].burst_time = getRandom(20);
-        processes[i].completion_time = 0;
-        processes[i].remaining_time = processes[i].burst_time;
-        processes[i].start_time = 0;
+// Replays the mapped trace through round robin. Only the processes that
+// have arrived and not finished have runtime state, and the metrics are
+// taken as each one finishes, so nothing holds the whole trace.
+int replay_trace(const Trace *trace, int time_quantum, EventLog *log,
+                 Metrics *metrics) {
+    MetricsStream stream;
+    if (metrics_stream_init(&stream, trace->count) != 0) {
+        fprintf(stderr, "could not allocate the metrics\n");
+        return -1;
     }
+    TraceSource source;
+    trace_source_init(&source, trace, add_to_metrics, &stream);
+    int status = round_robin_replay(&source.source, time_quantum, log);
+    if (status == 0) {
+        metrics_stream_finish(&stream, metrics);
+    }
+    trace_source_free(&source);
+    metrics_stream_free(&stream);
+    return status;
+}
 
-    qsort(processes, n, sizeof(Process), compare_arrival_time);
-    processes[0].arrival_time = 0;
-    processes[0].burst_time = 6;
+// usage: scheduler [process_count | --trace FILE]
+//                  [--seed S] [--arrivals poisson|bursty] [--rate R]
+//                  [--bursts exponential|bimodal|pareto] [--mean-burst M]
+//                  [--quantum Q] [--compare]
+//                  [--sweep FIRST:LAST[:STEP] [--seeds K] [--csv FILE]]
+//                  [--real [--unit MS]]
+//                  [--cores M] [--balance push|steal] [--interval T]
+//                  [--threads N]
+//                  [--log-level quiet|text] [--event-log FILE]
+int main(int argc, char *argv[]) {
 
-    printf("Generated Processes:\n");
-    printf("PID\tArrival\tBurst\n");
-    for (int i = 0; i < n; i++) {
-        printf("%d\t%d\t%d\n", processes[i].pid, processes[i].arrival_time,
-               processes[i].burst_time);
+    int n = DEFAULT_PROCESS_COUNT;
+    MulticoreConfig multicore = {1, 3, BALANCE_STEAL, 100, 1};
+    int compare = 0;
+    const char *trace_path = NULL;
+    WorkloadConfig workload;
+    workload_defaults(&workload);
+    workload.seed = random_seed();
+    int synthetic = 0; // --arrivals/--bursts given
+    SweepConfig sweep = {0, 0, 1, 1, 1};
+    int sweeping = 0;
+    const char *csv_path = NULL;
+    int real = 0;
+    double unit_ms = 10.0;
+    LogLevel log_level = LOG_TEXT;
+    const char *event_log_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            workload.seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--arrivals") == 0 && i + 1 < argc) {
+            i++;
+            synthetic = 1;
+            if (strcmp(argv[i], "poisson") == 0) {
+                workload.arrivals = ARRIVAL_POISSON;
+            } else if (strcmp(argv[i], "bursty") == 0) {
+                workload.arrivals = ARRIVAL_BURSTY;
+            } else {
+                fprintf(stderr, "unknown arrival process '%s'\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--bursts") == 0 && i + 1 < argc) {
+            i++;
+            synthetic = 1;
+            if (strcmp(argv[i], "exponential") == 0) {
+                workload.bursts = BURST_EXPONENTIAL;
+            } else if (strcmp(argv[i], "bimodal") == 0) {
+                workload.bursts = BURST_BIMODAL;
+            } else if (strcmp(argv[i], "pareto") == 0) {
+                workload.bursts = BURST_PARETO;
+            } else {
+                fprintf(stderr, "unknown burst distribution '%s'\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            workload.arrival_rate = atof(argv[++i]);
+            synthetic = 1;
+        } else if (strcmp(argv[i], "--mean-burst") == 0 && i + 1 < argc) {
+            workload.mean_burst = atof(argv[++i]);
+            synthetic = 1;
+        } else if (strcmp(argv[i], "--quantum") == 0 && i + 1 < argc) {
+            multicore.time_quantum = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sweep") == 0 && i + 1 < argc) {
+            sweeping = 1;
+            if (sscanf(argv[++i], "%d:%d:%d", &sweep.quantum_first,
+                       &sweep.quantum_last, &sweep.quantum_step) < 2) {
+                fprintf(stderr, "--sweep takes FIRST:LAST[:STEP]\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) {
+            sweep.seeds = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_path = argv[++i];
+        } else if (strcmp(argv[i], "--real") == 0) {
+            real = 1;
+        } else if (strcmp(argv[i], "--unit") == 0 && i + 1 < argc) {
+            unit_ms = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--log-level") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "quiet") == 0) {
+                log_level = LOG_QUIET;
+            } else if (strcmp(argv[i], "text") == 0) {
+                log_level = LOG_TEXT;
+            } else {
+                fprintf(stderr, "unknown log level '%s'\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--event-log") == 0 && i + 1 < argc) {
+            event_log_path = argv[++i];
+        } else if (strcmp(argv[i], "--compare") == 0) {
+            compare = 1;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--cores") == 0 && i + 1 < argc) {
+            multicore.cores = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--balance") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "push") == 0) {
+                multicore.balance = BALANCE_PUSH;
+            } else if (strcmp(argv[i], "steal") == 0) {
+                multicore.balance = BALANCE_STEAL;
+            } else {
+                fprintf(stderr, "unknown balance policy '%s'\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+            multicore.balance_interval = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            multicore.threads = atoi(argv[++i]);
+            sweep.threads = multicore.threads;
+        } else if (argv[i][0] != '-') {
+            n = atoi(argv[i]);
+        } else {
+            fprintf(stderr, "unknown option '%s'\n", argv[i]);
+            return 1;
+        }
+    }
+    if (n <= 0) {
+        fprintf(stderr, "process count must be positive\n");
+        return 1;
+    }
+    if (multicore.cores <= 0 || multicore.balance_interval <= 0 ||
+        multicore.time_quantum <= 0) {
+        fprintf(stderr, "quantum, cores and interval must be positive\n");
+        return 1;
+    }
+    if (unit_ms <= 0) {
+        fprintf(stderr, "unit must be positive\n");
+        return 1;
+    }
+    if (workload.arrival_rate <= 0 || workload.mean_burst <= 0) {
+        fprintf(stderr, "rate and mean burst must be positive\n");
+        return 1;
+    }
+    if (sweeping && (sweep_row_count(&sweep) == 0 || sweep.seeds <= 0 ||
+                     sweep.quantum_first <= 0)) {
+        fprintf(stderr, "quantum sweep needs 0 < FIRST <= LAST, STEP > 0 "
+                        "and --seeds > 0\n");
+        return 1;
+    }
+    if (sweeping && trace_path != NULL && sweep.seeds > 1) {
+        fprintf(stderr, "--seeds would only repeat the same trace\n");
+        return 1;
     }
+    if (event_log_path != NULL &&
+        (real || compare || sweeping || multicore.cores > 1)) {
+        fprintf(stderr, "--event-log needs the single-core simulator\n");
+        return 1;
+    }
+    // without --arrivals/--bursts, the original demo workload
+    workload.demo = !synthetic;
+
+    int time_quantum = multicore.time_quantum;
+    Process *processes = NULL;
+    Trace trace = {NULL, NULL, 0, NULL, 0};
+
+    if (trace_path != NULL) {
+        if (trace_open(&trace, trace_path) != 0)
+            return 1;
+        n = trace.count;
+        // the single-core simulator streams the records; the other modes
+        // need every process at once, so the trace has to fit in memory
+        int streaming = !sweeping && !compare && !real && multicore.cores == 1;
+        if (!streaming) {
+            processes = malloc((size_t)n * sizeof(Process));
+            if (processes == NULL) {
+                fprintf(stderr, "could not allocate %d processes\n", n);
+                trace_close(&trace);
+                return 1;
+            }
+            if (trace_read(&trace, processes) != 0) {
+                release_processes(processes, &trace);
+                return 1;
+            }
+        }
+        if (!sweeping) {
+            printf("Trace Processes:\n");
+        }
+    } else {
+        processes = malloc((size_t)n * sizeof(Process));
+        if (processes == NULL) {
+            fprintf(stderr, "could not allocate %d processes\n", n);
+            return 1;
+        }
 
-    printf("\n=== Round Robin Scheduling (Time Quantum: %d) ===\n",
-           time_quantum);
-    round_robin_schedule(processes, n, time_quantum);
+        // arrivals come out sorted
+        generate_workload(processes, n, &workload);
+        if (!sweeping) {
+            printf("Generated Processes (seed %llu):\n",
+                   (unsigned long long)workload.seed);
+        }
+    }
+
+    if (sweeping) {
+        int rows = sweep_row_count(&sweep);
+        SweepRow *results =
+            rows > 0 ? calloc((size_t)rows, sizeof(SweepRow)) : NULL;
+        // generated workloads get a fresh seed per run, a trace is fixed
+        const Process *base = trace_path != NULL ? processes : NULL;
+        int status = results == NULL ||
+                     quantum_sweep(base, n, &workload, &sweep, results) != 0;
+        if (status != 0) {
+            // the range was checked up front
+            fprintf(stderr, "out of memory for the quantum sweep\n");
+        } else {
+            FILE *csv = csv_path != NULL ? fopen(csv_path, "w") : stdout;
+            if (csv == NULL) {
+                fprintf(stderr, "could not open %s\n", csv_path);
+                status = 1;
+            } else {
+                write_sweep_csv(csv, results, rows);
+                if (csv != stdout) {
+                    fclose(csv);
+                }
+            }
+        }
+        free(results);
+        release_processes(processes, &trace);
+        return status;
+    }
+
+    int verbose = log_level == LOG_TEXT;
+    if (verbose) {
+        printf("PID\tArrival\tBurst\n");
+        for (int i = 0; i < n; i++) {
+            if (processes != NULL) {
+                printf("%d\t%d\t%d\n", processes[i].pid,
+                       processes[i].arrival_time, processes[i].burst_time);
+            } else {
+                printf("%d\t%d\t%d\n", trace.records[i].pid,
+                       trace.records[i].arrival_time,
+                       trace.records[i].burst_time);
+            }
+        }
+    }
+
+    if (compare) {
+        int status = compare_policies(processes, n, time_quantum);
+        if (status != 0) {
+            fprintf(stderr, "could not allocate the comparison runs\n");
+        }
+        release_processes(processes, &trace);
+        return status != 0;
+    }
+
+    CoreStats *core_stats = NULL;
+    int makespan = 0;
+    Metrics metrics;
+    int replayed = 0; // metrics already taken from the streamed trace
+    if (real) {
+        printf("\n=== Round Robin over Real Processes (Time Quantum: %d) ===\n",
+               time_quantum);
+        if (run_real_processes(processes, n, time_quantum, unit_ms,
+                               verbose) != 0) {
+            release_processes(processes, &trace);
+            return 1;
+        }
+    } else if (multicore.cores == 1) {
+        printf("\n=== Round Robin Scheduling (Time Quantum: %d) ===\n",
+               time_quantum);
+        // quiet with no file: record nothing at all
+        EventLog *log = NULL;
+        if (verbose || event_log_path != NULL) {
+            log = event_log_create(event_log_path, log_level, stdout);
+            if (log == NULL) {
+                fprintf(stderr, "could not create event log %s\n",
+                        event_log_path != NULL ? event_log_path : "");
+                release_processes(processes, &trace);
+                return 1;
+            }
+        }
+        int status = 0;
+        if (processes != NULL) {
+            round_robin_schedule(processes, n, time_quantum, log);
+        } else {
+            status = replay_trace(&trace, time_quantum, log, &metrics);
+            replayed = 1;
+        }
+        if (event_log_destroy(log) != 0) {
+            fprintf(stderr, "could not write event log %s\n",
+                    event_log_path);
+            release_processes(processes, &trace);
+            return 1;
+        }
+        if (status != 0) {
+            release_processes(processes, &trace);
+            return 1;
+        }
+    } else {
+        printf("\n=== Round Robin on %d Cores (Time Quantum: %d, %s) ===\n",
+               multicore.cores, time_quantum,
+               multicore.balance == BALANCE_PUSH ? "push migration"
+                                                 : "work stealing");
+        core_stats = calloc((size_t)multicore.cores, sizeof(CoreStats));
+        if (core_stats == NULL) {
+            fprintf(stderr, "could not allocate core statistics\n");
+            release_processes(processes, &trace);
+            return 1;
+        }
+        makespan = multicore_schedule(processes, n, &multicore, core_stats);
+        if (makespan < 0) {
+            fprintf(stderr, "multi-core simulation failed\n");
+            free(core_stats);
+            release_processes(processes, &trace);
+            return 1;
+        }
+    }
 
     // After "All processes completed!"
     printf("\n=== Summary ===\n");
-    for (int i = 0; i < n; i++) {
-        int turnaround =
-            processes[i].completion_time - processes[i].arrival_time;
-        int waiting = turnaround - processes[i].burst_time;
-        printf("P%d: Arrival=%d, Burst=%d, Completion=%d, Turnaround=%d, "
-               "Waiting=%d\n",
-               processes[i].pid, processes[i].arrival_time,
-               processes[i].burst_time, processes[i].completion_time,
-               turnaround, waiting);
+    // a streamed trace keeps no per-process results; its completions are
+    // in the event log
+    if (verbose && !replayed) {
+        for (int i = 0; i < n; i++) {
+            int turnaround =
+                processes[i].completion_time - processes[i].arrival_time;
+            int waiting = turnaround - processes[i].burst_time;
+            printf("P%d: Arrival=%d, Burst=%d, Completion=%d, "
+                   "Turnaround=%d, Waiting=%d\n",
+                   processes[i].pid, processes[i].arrival_time,
+                   processes[i].burst_time, processes[i].completion_time,
+                   turnaround, waiting);
+        }
+    } else if (replayed || compute_metrics(processes, n, &metrics) == 0) {
+        printf("Turnaround: mean %.2f, p99 %d\n", metrics.mean_turnaround,
+               metrics.p99_turnaround);
+        printf("Waiting: mean %.2f, p99 %d\n", metrics.mean_waiting,
+               metrics.p99_waiting);
+        printf("Response: mean %.2f, p99 %d\n", metrics.mean_response,
+               metrics.p99_response);
+    }
+    if (core_stats != NULL) {
+        print_multicore_summary(&multicore, core_stats, makespan);
+        free(core_stats);
     }
 
+    release_processes(processes, &trace);
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "metrics.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int compare_int(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// 1-based nearest rank of the p-th percentile of n values
+static int percentile_rank(int n, int p) {
+    int rank = (int)(((long long)p * n + 99) / 100);
+    return rank > 0 ? rank : 1;
+}
+
+// Nearest-rank percentile; sorts values
+static int percentile(int values[], int n, int p) {
+    qsort(values, n, sizeof(int), compare_int);
+    return values[percentile_rank(n, p) - 1];
+}
+
+int compute_metrics(const Process processes[], int n, Metrics *metrics) {
+    int *turnaround = malloc((size_t)n * sizeof(int));
+    int *waiting = malloc((size_t)n * sizeof(int));
+    int *response = malloc((size_t)n * sizeof(int));
+    if (turnaround == NULL || waiting == NULL || response == NULL) {
+        free(turnaround);
+        free(waiting);
+        free(response);
+        return -1;
+    }
+
+    double turnaround_sum = 0, waiting_sum = 0, response_sum = 0;
+    for (int i = 0; i < n; i++) {
+        turnaround[i] =
+            processes[i].completion_time - processes[i].arrival_time;
+        waiting[i] = turnaround[i] - processes[i].burst_time;
+        response[i] = processes[i].start_time - processes[i].arrival_time;
+        turnaround_sum += turnaround[i];
+        waiting_sum += waiting[i];
+        response_sum += response[i];
+    }
+
+    metrics->mean_turnaround = turnaround_sum / n;
+    metrics->mean_waiting = waiting_sum / n;
+    metrics->mean_response = response_sum / n;
+    metrics->p99_turnaround = percentile(turnaround, n, 99);
+    metrics->p99_waiting = percentile(waiting, n, 99);
+    metrics->p99_response = percentile(response, n, 99);
+
+    free(turnaround);
+    free(waiting);
+    free(response);
+    return 0;
+}
+
+int metrics_stream_init(MetricsStream *stream, int n) {
+    memset(stream, 0, sizeof(*stream));
+    stream->n = n;
+    // the p99 is the smallest of the values ranked at or above it
+    stream->keep = n - percentile_rank(n, 99) + 1;
+    for (int m = 0; m < 3; m++) {
+        stream->top[m] = malloc((size_t)stream->keep * sizeof(int));
+        if (stream->top[m] == NULL) {
+            metrics_stream_free(stream);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Keeps the keep largest values seen in a min-heap of heap[0..count)
+static void heap_offer(int heap[], int count, int keep, int value) {
+    int i;
+    if (count < keep) {
+        // sift the new leaf up
+        for (i = count; i > 0 && heap[(i - 1) / 2] > value; i = (i - 1) / 2) {
+            heap[i] = heap[(i - 1) / 2];
+        }
+        heap[i] = value;
+        return;
+    }
+    if (value <= heap[0])
+        return;
+
+    // replace the root and sift it down
+    i = 0;
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= keep)
+            break;
+        if (child + 1 < keep && heap[child + 1] < heap[child]) {
+            child++;
+        }
+        if (heap[child] >= value)
+            break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = value;
+}
+
+void metrics_stream_add(MetricsStream *stream, const Process *process) {
+    int turnaround = process->completion_time - process->arrival_time;
+    int waiting = turnaround - process->burst_time;
+    int response = process->start_time - process->arrival_time;
+    stream->turnaround_sum += turnaround;
+    stream->waiting_sum += waiting;
+    stream->response_sum += response;
+    heap_offer(stream->top[0], stream->added, stream->keep, turnaround);
+    heap_offer(stream->top[1], stream->added, stream->keep, waiting);
+    heap_offer(stream->top[2], stream->added, stream->keep, response);
+    stream->added++;
+}
+
+void metrics_stream_finish(const MetricsStream *stream, Metrics *metrics) {
+    metrics->mean_turnaround = stream->turnaround_sum / stream->n;
+    metrics->mean_waiting = stream->waiting_sum / stream->n;
+    metrics->mean_response = stream->response_sum / stream->n;
+    metrics->p99_turnaround = stream->top[0][0];
+    metrics->p99_waiting = stream->top[1][0];
+    metrics->p99_response = stream->top[2][0];
+}
+
+void metrics_stream_free(MetricsStream *stream) {
+    for (int m = 0; m < 3; m++) {
+        free(stream->top[m]);
+        stream->top[m] = NULL;
+    }
+}
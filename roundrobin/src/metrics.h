@@ -0,0 +1,38 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "scheduler.h"
+
+// Summary of a finished run
+typedef struct {
+    double mean_turnaround; // completion - arrival
+    int p99_turnaround;
+    double mean_waiting; // turnaround - burst
+    int p99_waiting;
+    double mean_response; // first start - arrival
+    int p99_response;
+} Metrics;
+
+// Fills metrics from the times recorded in processes[0..n). Returns 0, or
+// -1 if the scratch space for the percentiles can't be allocated.
+int compute_metrics(const Process processes[], int n, Metrics *metrics);
+
+// The same metrics for a run whose processes aren't all kept: add each one
+// as it finishes. The means are running sums, and a p99 only depends on
+// the largest 1% of values, so only those are held, in min-heaps.
+typedef struct {
+    int n;    // processes in the run
+    int keep; // values each heap holds
+    int added;
+    double turnaround_sum, waiting_sum, response_sum;
+    int *top[3]; // turnaround, waiting, response
+} MetricsStream;
+
+// Returns 0, or -1 if the heaps can't be allocated
+int metrics_stream_init(MetricsStream *stream, int n);
+void metrics_stream_add(MetricsStream *stream, const Process *process);
+// Fills metrics once all n processes have been added
+void metrics_stream_finish(const MetricsStream *stream, Metrics *metrics);
+void metrics_stream_free(MetricsStream *stream);
+
+#endif
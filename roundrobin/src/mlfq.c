@@ -0,0 +1,122 @@
+#include "policy.h"
+#include <stdlib.h>
+
+typedef struct {
+    Process *base; // level[] is indexed by position in processes[]
+    int *level;
+    Queue **queues; // queues[0] is the highest priority
+    int levels;
+    int base_quantum;
+    int boost_interval;
+    int next_boost;
+} Mlfq;
+
+// Moves every queued process back to the top level, keeping the order
+// of the levels and of the processes within each
+static void mlfq_boost(Mlfq *mlfq) {
+    for (int l = 1; l < mlfq->levels; l++) {
+        Process *process;
+        while ((process = dequeue(mlfq->queues[l])) != NULL) {
+            mlfq->level[process - mlfq->base] = 0;
+            enqueue(mlfq->queues[0], process);
+        }
+    }
+}
+
+static int mlfq_on_arrival(Policy *policy, Process *process, int now) {
+    (void)now;
+    Mlfq *mlfq = policy->state;
+    mlfq->level[process - mlfq->base] = 0;
+    enqueue(mlfq->queues[0], process);
+    return 0;
+}
+
+static Process *mlfq_pick_next(Policy *policy, int now, int *slice) {
+    Mlfq *mlfq = policy->state;
+    if (now >= mlfq->next_boost) {
+        mlfq_boost(mlfq);
+        mlfq->next_boost = now + mlfq->boost_interval;
+    }
+    for (int l = 0; l < mlfq->levels; l++) {
+        if (!is_empty(mlfq->queues[l])) {
+            *slice = mlfq->base_quantum << l;
+            return dequeue(mlfq->queues[l]);
+        }
+    }
+    return NULL;
+}
+
+// A slice only ends early when the process finishes, so a preempted
+// process always used its whole quantum and drops a level
+static void mlfq_on_tick(Policy *policy, Process *process, int ran, int now) {
+    (void)ran;
+    (void)now;
+    Mlfq *mlfq = policy->state;
+    int *level = &mlfq->level[process - mlfq->base];
+    if (*level < mlfq->levels - 1) {
+        (*level)++;
+    }
+    enqueue(mlfq->queues[*level], process);
+}
+
+static void mlfq_on_complete(Policy *policy, Process *process, int now) {
+    (void)policy;
+    (void)process;
+    (void)now;
+}
+
+static void mlfq_destroy(Policy *policy) {
+    Mlfq *mlfq = policy->state;
+    for (int l = 0; l < mlfq->levels; l++) {
+        if (mlfq->queues[l] != NULL) {
+            free_queue(mlfq->queues[l]);
+        }
+    }
+    free(mlfq->queues);
+    free(mlfq->level);
+    free(mlfq);
+    free(policy);
+}
+
+Policy *create_mlfq_policy(Process processes[], int n, int levels,
+                           int base_quantum, int boost_interval) {
+    if (levels < 1 || levels > 16 || base_quantum < 1 || boost_interval < 1)
+        return NULL;
+
+    Policy *policy = malloc(sizeof(Policy));
+    Mlfq *mlfq = calloc(1, sizeof(Mlfq));
+    if (policy == NULL || mlfq == NULL) {
+        free(policy);
+        free(mlfq);
+        return NULL;
+    }
+
+    policy->name = "MLFQ";
+    policy->state = mlfq;
+    policy->on_arrival = mlfq_on_arrival;
+    policy->pick_next = mlfq_pick_next;
+    policy->on_tick = mlfq_on_tick;
+    policy->on_complete = mlfq_on_complete;
+    policy->destroy = mlfq_destroy;
+
+    mlfq->base = processes;
+    mlfq->levels = levels;
+    mlfq->base_quantum = base_quantum;
+    mlfq->boost_interval = boost_interval;
+    mlfq->next_boost = boost_interval;
+    mlfq->level = malloc((size_t)n * sizeof(int));
+    mlfq->queues = calloc((size_t)levels, sizeof(Queue *));
+    if (mlfq->level == NULL || mlfq->queues == NULL) {
+        mlfq->levels = 0;
+        mlfq_destroy(policy);
+        return NULL;
+    }
+    for (int l = 0; l < levels; l++) {
+        mlfq->queues[l] = create_queue(n);
+        if (mlfq->queues[l] == NULL) {
+            mlfq_destroy(policy);
+            return NULL;
+        }
+    }
+    return policy;
+}
@@ -0,0 +1,376 @@
+#include "multicore.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    Queue *ready;
+    Process **pending; // arrivals assigned to this core for the current
+                       // round, in arrival order
+    int pending_count;
+    int pending_capacity;
+    int time;            // local clock
+    int last_completion; // completion time of the last process finished
+    CoreStats stats;
+} Core;
+
+typedef struct Simulation Simulation;
+
+typedef struct {
+    Simulation *sim;
+    int first_core;
+} Worker;
+
+struct Simulation {
+    Core *cores;
+    int core_count;
+    int time_quantum;
+    int limit; // end of the current round
+
+    // worker threads, each simulating every thread_count-th core
+    pthread_t *threads;
+    Worker *workers;
+    int thread_count;
+    int round;   // bumped to start a round
+    int running; // workers still busy with it
+    int stopping;
+};
+
+static int push_pending(Core *core, Process *process) {
+    if (core->pending_count == core->pending_capacity) {
+        int capacity = core->pending_capacity ? core->pending_capacity * 2 : 64;
+        Process **pending =
+            realloc(core->pending, (size_t)capacity * sizeof(Process *));
+        if (pending == NULL)
+            return -1;
+        core->pending = pending;
+        core->pending_capacity = capacity;
+    }
+    core->pending[core->pending_count++] = process;
+    return 0;
+}
+
+// Round robin on one core until its clock reaches limit. Same rules as
+// round_robin_schedule: a preempted process goes back in before the
+// arrivals that happened during its slice. A slice that starts before
+// limit runs to its end, so the clock can overshoot into the next round.
+static void run_core(Core *core, int time_quantum, int limit) {
+    int next = 0;
+
+    while (1) {
+        while (next < core->pending_count &&
+               core->pending[next]->arrival_time <= core->time) {
+            enqueue(core->ready, core->pending[next]);
+            next++;
+        }
+        if (core->time >= limit)
+            break;
+        if (is_empty(core->ready)) {
+            if (next < core->pending_count) {
+                core->time = core->pending[next]->arrival_time;
+                continue;
+            }
+            core->time = limit;
+            break;
+        }
+
+        Process *process = dequeue(core->ready);
+        if (process->burst_time == process->remaining_time) {
+            process->start_time = core->time;
+        }
+
+        int execution_time = (process->remaining_time < time_quantum)
+                                 ? process->remaining_time
+                                 : time_quantum;
+        process->remaining_time -= execution_time;
+        core->time += execution_time;
+        core->stats.busy_time += execution_time;
+        core->stats.slices++;
+
+        if (process->remaining_time == 0) {
+            process->completion_time = core->time;
+            core->last_completion = core->time;
+            core->stats.completed++;
+        } else {
+            enqueue(core->ready, process);
+        }
+
+        while (next < core->pending_count &&
+               core->pending[next]->arrival_time < core->time) {
+            enqueue(core->ready, core->pending[next]);
+            next++;
+        }
+    }
+    core->pending_count = 0;
+}
+
+static void run_cores(Simulation *sim, int first_core) {
+    for (int i = first_core; i < sim->core_count; i += sim->thread_count) {
+        run_core(&sim->cores[i], sim->time_quantum, sim->limit);
+    }
+}
+
+// Rounds are short (a few slices per core), so the workers spin on the
+// round counter rather than sleeping on a condition variable, whose wake-up
+// latency would cost more than the round itself. After a while they yield.
+#define SPINS_BEFORE_YIELD 4096
+
+static void wait_while_equal(const int *value, int expected) {
+    int spins = 0;
+    while (__atomic_load_n(value, __ATOMIC_ACQUIRE) == expected) {
+        if (++spins >= SPINS_BEFORE_YIELD) {
+            sched_yield();
+            spins = 0;
+        }
+    }
+}
+
+static void *worker_main(void *arg) {
+    Worker *worker = arg;
+    Simulation *sim = worker->sim;
+    int seen = 0;
+
+    while (1) {
+        wait_while_equal(&sim->round, seen);
+        seen = __atomic_load_n(&sim->round, __ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&sim->stopping, __ATOMIC_ACQUIRE))
+            break;
+
+        run_cores(sim, worker->first_core);
+        __atomic_fetch_sub(&sim->running, 1, __ATOMIC_RELEASE);
+    }
+    return NULL;
+}
+
+// Runs one round on every core; the calling thread takes the first share
+static void run_round(Simulation *sim) {
+    if (sim->thread_count > 1) {
+        __atomic_store_n(&sim->running, sim->thread_count - 1,
+                         __ATOMIC_RELAXED);
+        __atomic_fetch_add(&sim->round, 1, __ATOMIC_RELEASE);
+    }
+
+    run_cores(sim, 0);
+
+    if (sim->thread_count > 1) {
+        int spins = 0;
+        while (__atomic_load_n(&sim->running, __ATOMIC_ACQUIRE) > 0) {
+            if (++spins >= SPINS_BEFORE_YIELD) {
+                sched_yield();
+                spins = 0;
+            }
+        }
+    }
+}
+
+static int start_workers(Simulation *sim) {
+    sim->round = 0;
+    sim->running = 0;
+    sim->stopping = 0;
+
+    sim->threads = calloc((size_t)sim->thread_count, sizeof(pthread_t));
+    sim->workers = calloc((size_t)sim->thread_count, sizeof(Worker));
+    if (sim->threads == NULL || sim->workers == NULL) {
+        sim->thread_count = 1;
+        return -1;
+    }
+
+    for (int i = 1; i < sim->thread_count; i++) {
+        sim->workers[i].sim = sim;
+        sim->workers[i].first_core = i;
+        if (pthread_create(&sim->threads[i], NULL, worker_main,
+                           &sim->workers[i]) != 0) {
+            // run with the threads that did start
+            sim->thread_count = i;
+            break;
+        }
+    }
+    return 0;
+}
+
+static void stop_workers(Simulation *sim) {
+    __atomic_store_n(&sim->stopping, 1, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&sim->round, 1, __ATOMIC_RELEASE);
+
+    for (int i = 1; i < sim->thread_count; i++) {
+        pthread_join(sim->threads[i], NULL);
+    }
+    free(sim->threads);
+    free(sim->workers);
+}
+
+// Makes room for needed entries, at least doubling so repeated small
+// increases don't reallocate every round
+static int ensure_capacity(Queue *queue, int needed) {
+    if (needed <= queue->capacity)
+        return 0;
+    if (needed < queue->capacity * 2) {
+        needed = queue->capacity * 2;
+    }
+    return reserve_queue(queue, needed);
+}
+
+// Processes on or headed for a core this round
+static int core_load(const Core *core) {
+    return core->ready->size + core->pending_count;
+}
+
+// Moves the oldest queued process of from to the back of to. The
+// receiving core can't run it before the donor re-queued it.
+static int migrate(Core *from, Core *to) {
+    if (ensure_capacity(to->ready, to->ready->size + 1) != 0)
+        return -1;
+    enqueue(to->ready, dequeue(from->ready));
+    if (to->time < from->time) {
+        to->time = from->time;
+    }
+    from->stats.migrations_out++;
+    to->stats.migrations_in++;
+    return 0;
+}
+
+static int push_balance(Simulation *sim) {
+    while (1) {
+        Core *busiest = NULL;
+        Core *idlest = &sim->cores[0];
+        for (int i = 0; i < sim->core_count; i++) {
+            Core *core = &sim->cores[i];
+            if (busiest == NULL || core->ready->size > busiest->ready->size)
+                busiest = core;
+            if (core_load(core) < core_load(idlest))
+                idlest = core;
+        }
+        if (busiest->ready->size - core_load(idlest) <= 1)
+            return 0;
+        if (migrate(busiest, idlest) != 0)
+            return -1;
+    }
+}
+
+static int steal_balance(Simulation *sim) {
+    for (int i = 0; i < sim->core_count; i++) {
+        Core *thief = &sim->cores[i];
+        if (core_load(thief) > 0)
+            continue;
+
+        Core *busiest = &sim->cores[0];
+        for (int j = 1; j < sim->core_count; j++) {
+            if (sim->cores[j].ready->size > busiest->ready->size)
+                busiest = &sim->cores[j];
+        }
+        for (int take = busiest->ready->size / 2; take > 0; take--) {
+            if (migrate(busiest, thief) != 0)
+                return -1;
+        }
+    }
+    return 0;
+}
+
+int multicore_schedule(Process processes[], int n,
+                       const MulticoreConfig *config, CoreStats stats[]) {
+    if (n <= 0 || config->cores <= 0 || config->time_quantum <= 0 ||
+        config->balance_interval <= 0)
+        return -1;
+
+    Simulation sim;
+    memset(&sim, 0, sizeof(sim));
+    sim.core_count = config->cores;
+    sim.time_quantum = config->time_quantum;
+    sim.thread_count = config->threads < 1 ? 1 : config->threads;
+    if (sim.thread_count > sim.core_count) {
+        sim.thread_count = sim.core_count;
+    }
+
+    int result = -1;
+    sim.cores = calloc((size_t)sim.core_count, sizeof(Core));
+    if (sim.cores == NULL)
+        return -1;
+    for (int i = 0; i < sim.core_count; i++) {
+        sim.cores[i].ready = create_queue(64);
+        if (sim.cores[i].ready == NULL)
+            goto cleanup;
+    }
+    if (start_workers(&sim) != 0) {
+        stop_workers(&sim);
+        goto cleanup;
+    }
+
+    int next_arrival = 0;
+    int dealt = 0; // round robin dealing position for BALANCE_STEAL
+    int round_start = processes[0].arrival_time;
+    long long completed = 0;
+
+    while (completed < n) {
+        sim.limit = round_start + config->balance_interval;
+
+        // hand out this round's arrivals
+        while (next_arrival < n &&
+               processes[next_arrival].arrival_time < sim.limit) {
+            Core *target;
+            if (config->balance == BALANCE_PUSH) {
+                target = &sim.cores[0];
+                for (int i = 1; i < sim.core_count; i++) {
+                    if (core_load(&sim.cores[i]) < core_load(target))
+                        target = &sim.cores[i];
+                }
+            } else {
+                target = &sim.cores[dealt];
+                dealt = (dealt + 1) % sim.core_count;
+            }
+            if (push_pending(target, &processes[next_arrival]) != 0)
+                goto stop;
+            next_arrival++;
+        }
+
+        int balanced = config->balance == BALANCE_PUSH ? push_balance(&sim)
+                                                        : steal_balance(&sim);
+        if (balanced != 0)
+            goto stop;
+
+        // during the round a core's queue holds at most what it has now
+        // plus its arrivals, so the cores never allocate while running
+        for (int i = 0; i < sim.core_count; i++) {
+            Core *core = &sim.cores[i];
+            if (ensure_capacity(core->ready,
+                                core->ready->size + core->pending_count) != 0)
+                goto stop;
+        }
+
+        run_round(&sim);
+
+        completed = 0;
+        int queued = 0;
+        for (int i = 0; i < sim.core_count; i++) {
+            completed += sim.cores[i].stats.completed;
+            queued += sim.cores[i].ready->size;
+        }
+
+        round_start = sim.limit;
+        // nothing left to run: skip straight to the next arrival
+        if (queued == 0 && next_arrival < n &&
+            processes[next_arrival].arrival_time > round_start) {
+            round_start = processes[next_arrival].arrival_time;
+        }
+    }
+
+    result = 0;
+    for (int i = 0; i < sim.core_count; i++) {
+        stats[i] = sim.cores[i].stats;
+        if (sim.cores[i].last_completion > result) {
+            result = sim.cores[i].last_completion;
+        }
+    }
+
+stop:
+    stop_workers(&sim);
+cleanup:
+    for (int i = 0; i < sim.core_count; i++) {
+        if (sim.cores[i].ready != NULL) {
+            free_queue(sim.cores[i].ready);
+        }
+        free(sim.cores[i].pending);
+    }
+    free(sim.cores);
+    return result;
+}
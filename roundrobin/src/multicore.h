@@ -0,0 +1,41 @@
+#ifndef MULTICORE_H
+#define MULTICORE_H
+
+#include "scheduler.h"
+
+// How work is spread over the cores
+typedef enum {
+    BALANCE_PUSH,  // arrivals go to the least loaded core, and the balancer
+                   // pushes queued processes from the busiest core to the
+                   // least loaded one until they differ by at most one
+    BALANCE_STEAL, // arrivals are dealt out round robin, and a core with
+                   // nothing queued steals half of the busiest core's queue
+} BalancePolicy;
+
+typedef struct {
+    int cores;            // number of simulated CPUs
+    int time_quantum;     // round robin quantum on every core
+    BalancePolicy balance;
+    int balance_interval; // time units between load balancing rounds
+    int threads;          // threads simulating the cores, 1 = serial
+} MulticoreConfig;
+
+// Per core results
+typedef struct {
+    long long busy_time;      // time units spent executing processes
+    long long slices;         // time slices run
+    long long completed;      // processes that finished on this core
+    long long migrations_in;  // processes moved onto this core
+    long long migrations_out; // processes moved off this core
+} CoreStats;
+
+// Round robin on config->cores CPUs, each with its own ready queue.
+// processes[] must be sorted by arrival time. Between balancing rounds
+// the cores are independent, so they are simulated in parallel; arrivals
+// are assigned and processes migrated only at the rounds, which keeps
+// the result the same for any thread count. Fills stats[0..cores) and
+// returns the makespan, or -1 on bad arguments or allocation failure.
+int multicore_schedule(Process processes[], int n,
+                       const MulticoreConfig *config, CoreStats stats[]);
+
+#endif
@@ -0,0 +1,204 @@
+#include "policy.h"
+#include <stdlib.h>
+
+// Discrete-event loop: the source is a cursor over the arrivals, so each
+// process is admitted once, and idle gaps jump straight to the next
+// arrival. The cost is O(n + slices) plus the policy's own work.
+int simulate_source(ProcessSource *source, Policy *policy, EventLog *log,
+                    SimulationStats *stats) {
+    int n = source->count;
+    int current_time = 0;
+    int completed = 0;
+    int admitted = 0;
+    int next_arrival = n > 0 ? source->next_arrival(source) : 0;
+    Process *last = NULL;
+    SimulationStats totals = {0, 0, 0};
+
+    while (completed < n) {
+        // admit everything that has arrived by now
+        while (admitted < n && next_arrival <= current_time) {
+            Process *arrival = source->admit(source);
+            if (arrival == NULL ||
+                policy->on_arrival(policy, arrival, current_time) != 0)
+                return -1;
+            event_log_record(log, EVENT_ARRIVE, current_time, arrival->pid,
+                             0);
+            if (++admitted < n) {
+                next_arrival = source->next_arrival(source);
+            }
+        }
+
+        int slice = 0;
+        Process *process = policy->pick_next(policy, current_time, &slice);
+        if (process == NULL) {
+            // nothing runnable, skip ahead to the next arrival
+            event_log_record(log, EVENT_IDLE, current_time, -1,
+                             next_arrival - current_time);
+            current_time = next_arrival;
+            continue;
+        }
+
+        // set the start time for first time process execution
+        if (process->burst_time == process->remaining_time) {
+            process->start_time = current_time;
+        }
+
+        int execution_time =
+            (process->remaining_time < slice) ? process->remaining_time : slice;
+
+        event_log_record(log, EVENT_RUN, current_time, process->pid,
+                         execution_time);
+
+        totals.slices++;
+        if (process != last) {
+            totals.context_switches++;
+            last = process;
+        }
+        process->remaining_time -= execution_time;
+        current_time += execution_time;
+
+        if (process->remaining_time == 0) {
+            process->completion_time = current_time;
+            completed++;
+            policy->on_complete(policy, process, current_time);
+            event_log_record(log, EVENT_COMPLETE, current_time, process->pid,
+                             0);
+            // the source may hand this memory to the next arrival
+            last = NULL;
+            if (source->release != NULL) {
+                source->release(source, process);
+            }
+        } else {
+            policy->on_tick(policy, process, execution_time, current_time);
+        }
+
+        // add processes that arrived during the execution time; they queue
+        // up behind the preempted process, arrivals at exactly
+        // current_time are admitted at the top of the next iteration
+        while (admitted < n && next_arrival < current_time) {
+            Process *arrival = source->admit(source);
+            if (arrival == NULL ||
+                policy->on_arrival(policy, arrival, current_time) != 0)
+                return -1;
+            event_log_record(log, EVENT_ARRIVE_DURING, current_time,
+                             arrival->pid, 0);
+            if (++admitted < n) {
+                next_arrival = source->next_arrival(source);
+            }
+        }
+    }
+
+    totals.makespan = current_time;
+    if (stats != NULL) {
+        *stats = totals;
+    }
+    return 0;
+}
+
+static int array_next_arrival(ProcessSource *source) {
+    ArraySource *array = source->state;
+    return array->processes[array->next].arrival_time;
+}
+
+static Process *array_admit(ProcessSource *source) {
+    ArraySource *array = source->state;
+    return &array->processes[array->next++];
+}
+
+void array_source_init(ProcessSource *source, ArraySource *array,
+                       Process processes[], int n) {
+    array->processes = processes;
+    array->next = 0;
+    source->state = array;
+    source->count = n;
+    source->next_arrival = array_next_arrival;
+    source->admit = array_admit;
+    source->release = NULL;
+}
+
+void simulate(Process processes[], int n, Policy *policy, EventLog *log,
+              SimulationStats *stats) {
+    ArraySource array;
+    ProcessSource source;
+    array_source_init(&source, &array, processes, n);
+    simulate_source(&source, policy, log, stats);
+}
+
+void destroy_policy(Policy *policy) {
+    if (policy != NULL) {
+        policy->destroy(policy);
+    }
+}
+
+// Round robin
+
+typedef struct {
+    Queue *ready;
+    int time_quantum;
+} RoundRobin;
+
+static int rr_on_arrival(Policy *policy, Process *process, int now) {
+    (void)now;
+    RoundRobin *rr = policy->state;
+    Queue *ready = rr->ready;
+    // only when more processes are live than the queue was sized for
+    if (ready->size == ready->capacity &&
+        reserve_queue(ready, 2 * ready->capacity) != 0)
+        return -1;
+    enqueue(ready, process);
+    return 0;
+}
+
+static Process *rr_pick_next(Policy *policy, int now, int *slice) {
+    (void)now;
+    RoundRobin *rr = policy->state;
+    *slice = rr->time_quantum;
+    return dequeue(rr->ready);
+}
+
+static void rr_on_tick(Policy *policy, Process *process, int ran, int now) {
+    (void)ran;
+    (void)now;
+    RoundRobin *rr = policy->state;
+    enqueue(rr->ready, process);
+}
+
+static void rr_on_complete(Policy *policy, Process *process, int now) {
+    (void)policy;
+    (void)process;
+    (void)now;
+}
+
+static void rr_destroy(Policy *policy) {
+    RoundRobin *rr = policy->state;
+    free_queue(rr->ready);
+    free(rr);
+    free(policy);
+}
+
+Policy *create_rr_policy(Process processes[], int n, int time_quantum) {
+    (void)processes;
+    Policy *policy = malloc(sizeof(Policy));
+    RoundRobin *rr = malloc(sizeof(RoundRobin));
+    Queue *ready = create_queue(n);
+    if (policy == NULL || rr == NULL || ready == NULL) {
+        free(policy);
+        free(rr);
+        if (ready != NULL) {
+            free_queue(ready);
+        }
+        return NULL;
+    }
+
+    rr->ready = ready;
+    rr->time_quantum = time_quantum;
+
+    policy->name = "RR";
+    policy->state = rr;
+    policy->on_arrival = rr_on_arrival;
+    policy->pick_next = rr_pick_next;
+    policy->on_tick = rr_on_tick;
+    policy->on_complete = rr_on_complete;
+    policy->destroy = rr_destroy;
+    return policy;
+}
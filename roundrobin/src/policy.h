@@ -0,0 +1,96 @@
+#ifndef POLICY_H
+#define POLICY_H
+
+#include "eventlog.h"
+#include "scheduler.h"
+
+// A scheduling policy, driven by simulate(). The policy owns the set of
+// ready processes; the driver only tells it what happened.
+typedef struct Policy Policy;
+struct Policy {
+    const char *name;
+    void *state;
+
+    // process became ready for the first time at now; returns 0, or -1 if
+    // the policy couldn't make room for it
+    int (*on_arrival)(Policy *policy, Process *process, int now);
+    // removes and returns the process to run next, or NULL if nothing is
+    // ready; *slice is the longest it may run before being preempted
+    Process *(*pick_next)(Policy *policy, int now, int *slice);
+    // process ran for ran units and was preempted with work left; the
+    // policy takes it back
+    void (*on_tick)(Policy *policy, Process *process, int ran, int now);
+    // process finished at now
+    void (*on_complete)(Policy *policy, Process *process, int now);
+    void (*destroy)(Policy *policy);
+};
+
+typedef struct {
+    long long slices;           // dispatches
+    long long context_switches; // dispatches of a different process than
+                                // the one that ran last
+    int makespan;               // completion time of the last process
+} SimulationStats;
+
+// Hands simulate_source() its processes in arrival order. A source can
+// create a process's runtime state when it is admitted and reuse it once
+// the process has finished, so only the live ones need memory.
+typedef struct ProcessSource ProcessSource;
+struct ProcessSource {
+    void *state;
+    int count; // processes in all
+    // arrival time of the next process; only called while some are left
+    int (*next_arrival)(ProcessSource *source);
+    // the next process, ready to run, or NULL if it can't be admitted
+    Process *(*admit)(ProcessSource *source);
+    // process has finished and been logged; may be NULL
+    void (*release)(ProcessSource *source, Process *process);
+};
+
+// Runs every process from source to completion under policy. Arrivals
+// during a slice are handed to the policy after the preempted process, so
+// they queue up behind it. Every arrival, slice, idle gap and completion
+// is recorded in log; log and stats may be NULL. Returns 0, or -1 if the
+// source or the policy failed to admit a process.
+int simulate_source(ProcessSource *source, Policy *policy, EventLog *log,
+                    SimulationStats *stats);
+
+// A source over processes[0..n), sorted by arrival time, whose processes
+// are run in place
+typedef struct {
+    Process *processes;
+    int next;
+} ArraySource;
+
+void array_source_init(ProcessSource *source, ArraySource *array,
+                       Process processes[], int n);
+
+// simulate_source over processes[] (sorted by arrival time), run in
+// place. Policies sized for n always have room, so this can't fail.
+void simulate(Process processes[], int n, Policy *policy, EventLog *log,
+              SimulationStats *stats);
+
+// The constructors size their state for processes[0..n) and return NULL
+// if it can't be allocated. Free with destroy_policy.
+
+// Plain round robin with a fixed quantum. processes may be NULL; n only
+// sizes the ready queue, which grows if more processes are live at once.
+Policy *create_rr_policy(Process processes[], int n, int time_quantum);
+
+// Multi-level feedback queue. New processes start at the top level; a
+// process that uses its whole slice drops a level, and each level below
+// doubles the quantum. Every boost_interval time units everything moves
+// back to the top so long jobs can't starve.
+Policy *create_mlfq_policy(Process processes[], int n, int levels,
+                           int base_quantum, int boost_interval);
+
+// CFS-style fair scheduling: always runs the process with the least
+// virtual runtime, kept in a pairing heap so pick-next is O(log n)
+// amortized. The slice is target_latency split over the runnable
+// processes, but never less than min_granularity.
+Policy *create_cfs_policy(Process processes[], int n, int target_latency,
+                          int min_granularity);
+
+void destroy_policy(Policy *policy);
+
+#endif
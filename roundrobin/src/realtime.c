@@ -0,0 +1,289 @@
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+#include "realtime.h"
+#include <stdio.h>
+
+#ifdef __linux__
+#include "policy.h"
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/timerfd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+    pid_t child;
+    clockid_t cpu_clock;
+    double first_run_ms;  // since the start of the run
+    double completion_ms; // since the start of the run
+    double cpu_ms;        // from the child's CPU clock
+    double rusage_ms;     // user + system time from wait4
+    long voluntary_switches;
+    long involuntary_switches;
+} RealProcess;
+
+static double now_ms(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e3 + now.tv_nsec / 1e6;
+}
+
+static double cpu_clock_ms(clockid_t clock) {
+    struct timespec used;
+    if (clock_gettime(clock, &used) != 0)
+        return 0.0;
+    return used.tv_sec * 1e3 + used.tv_nsec / 1e6;
+}
+
+// Blocks until CLOCK_MONOTONIC reaches at_ms. Returns 0, or -1 if the
+// timer can't be armed or read.
+static int sleep_until(int timer, double at_ms) {
+    struct itimerspec when;
+    memset(&when, 0, sizeof(when));
+    if (at_ms <= 0) {
+        at_ms = 1e-6;
+    }
+    when.it_value.tv_sec = (time_t)(at_ms / 1e3);
+    when.it_value.tv_nsec =
+        (long)((at_ms - when.it_value.tv_sec * 1e3) * 1e6);
+    if (timerfd_settime(timer, TFD_TIMER_ABSTIME, &when, NULL) != 0)
+        return -1;
+    uint64_t expirations;
+    while (read(timer, &expirations, sizeof(expirations)) < 0) {
+        if (errno != EINTR)
+            return -1;
+    }
+    return 0;
+}
+
+// A CPU-bound child, stopped before it does any work
+static pid_t spawn_stopped(void) {
+    pid_t child = fork();
+    if (child == 0) {
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        raise(SIGSTOP);
+        volatile unsigned long spin = 0;
+        for (;;) {
+            spin++;
+        }
+    }
+    if (child < 0)
+        return -1;
+
+    int status;
+    if (waitpid(child, &status, WUNTRACED) != child || !WIFSTOPPED(status)) {
+        kill(child, SIGKILL);
+        waitpid(child, &status, 0);
+        return -1;
+    }
+    return child;
+}
+
+static void reap(RealProcess *real) {
+    int status;
+    struct rusage usage;
+    kill(real->child, SIGKILL);
+    if (wait4(real->child, &status, 0, &usage) == real->child) {
+        real->rusage_ms = usage.ru_utime.tv_sec * 1e3 +
+                          usage.ru_utime.tv_usec / 1e3 +
+                          usage.ru_stime.tv_sec * 1e3 +
+                          usage.ru_stime.tv_usec / 1e3;
+        real->voluntary_switches = usage.ru_nvcsw;
+        real->involuntary_switches = usage.ru_nivcsw;
+    }
+    real->child = 0;
+}
+
+int run_real_processes(Process processes[], int n, int time_quantum,
+                       double unit_ms, int verbose) {
+    if (n > REAL_MAX_PROCESSES) {
+        fprintf(stderr, "real mode runs at most %d processes\n",
+                REAL_MAX_PROCESSES);
+        return -1;
+    }
+
+    // the simulated run of the same workload, for comparison
+    Process *simulated = malloc((size_t)n * sizeof(Process));
+    RealProcess *real = calloc((size_t)n, sizeof(RealProcess));
+    Queue *ready = create_queue(n);
+    Policy *policy = simulated ? create_rr_policy(simulated, n, time_quantum)
+                               : NULL;
+    int timer = timerfd_create(CLOCK_MONOTONIC, 0);
+    int status = -1;
+    if (simulated == NULL || real == NULL || ready == NULL ||
+        policy == NULL || timer < 0) {
+        fprintf(stderr, "could not set up the real-process run\n");
+        goto cleanup;
+    }
+    memcpy(simulated, processes, (size_t)n * sizeof(Process));
+    simulate(simulated, n, policy, NULL, NULL);
+
+    for (int i = 0; i < n; i++) {
+        real[i].child = spawn_stopped();
+        if (real[i].child < 0 ||
+            clock_getcpuclockid(real[i].child, &real[i].cpu_clock) != 0) {
+            fprintf(stderr, "could not start a child for P%d\n",
+                    processes[i].pid);
+            if (real[i].child < 0) {
+                real[i].child = 0;
+            }
+            goto cleanup;
+        }
+    }
+
+    int completed = 0;
+    int next_arrival = 0;
+    long switches = 0;
+    double switch_total_ms = 0, switch_max_ms = 0;
+    double expired_at = -1; // when the last slice's timer fired
+    double start = now_ms();
+
+    while (completed < n) {
+        double elapsed = (now_ms() - start) / unit_ms;
+        while (next_arrival < n &&
+               processes[next_arrival].arrival_time <= elapsed) {
+            enqueue(ready, &processes[next_arrival]);
+            next_arrival++;
+        }
+        if (is_empty(ready)) {
+            double arrival_ms =
+                start + processes[next_arrival].arrival_time * unit_ms;
+            if (sleep_until(timer, arrival_ms) != 0) {
+                perror("timerfd");
+                goto cleanup;
+            }
+            expired_at = -1;
+            continue;
+        }
+
+        Process *process = dequeue(ready);
+        RealProcess *child = &real[process - processes];
+        int slice = process->remaining_time < time_quantum
+                        ? process->remaining_time
+                        : time_quantum;
+
+        double resumed = now_ms();
+        if (slice > 0) {
+            kill(child->child, SIGCONT);
+        }
+        if (expired_at >= 0) {
+            // stopping the last child and picking and resuming this one
+            double cost = now_ms() - expired_at;
+            switch_total_ms += cost;
+            if (cost > switch_max_ms) {
+                switch_max_ms = cost;
+            }
+            switches++;
+        }
+        if (process->burst_time == process->remaining_time) {
+            child->first_run_ms = resumed - start;
+            process->start_time = (int)((resumed - start) / unit_ms + 0.5);
+        }
+
+        if (slice > 0) {
+            if (sleep_until(timer, resumed + slice * unit_ms) != 0) {
+                perror("timerfd");
+                goto cleanup;
+            }
+            expired_at = now_ms();
+            int stopped;
+            kill(child->child, SIGSTOP);
+            waitpid(child->child, &stopped, WUNTRACED);
+        }
+        process->remaining_time -= slice;
+
+        if (verbose) {
+            printf("%.2f-%.2f ms: Process P%d, cpu %.2f ms so far\n",
+                   resumed - start, now_ms() - start, process->pid,
+                   cpu_clock_ms(child->cpu_clock));
+        }
+
+        if (process->remaining_time == 0) {
+            double done = now_ms() - start;
+            child->completion_ms = done;
+            child->cpu_ms = cpu_clock_ms(child->cpu_clock);
+            process->completion_time = (int)(done / unit_ms + 0.5);
+            reap(child);
+            completed++;
+        } else {
+            enqueue(ready, process);
+        }
+
+        elapsed = (now_ms() - start) / unit_ms;
+        while (next_arrival < n &&
+               processes[next_arrival].arrival_time <= elapsed) {
+            enqueue(ready, &processes[next_arrival]);
+            next_arrival++;
+        }
+    }
+
+    printf("\n=== Real vs Simulated (1 unit = %.2f ms) ===\n", unit_ms);
+    printf("PID\tBurst\tSimStart\tRealStart\tSimDone\tRealDone\tCPU ms"
+           "\tRusage ms\tLatency ms\tVol/Invol\n");
+    double cpu_total = 0, drift_total = 0;
+    for (int i = 0; i < n; i++) {
+        const RealProcess *r = &real[i];
+        double latency = r->first_run_ms - processes[i].arrival_time * unit_ms;
+        printf("P%d\t%d\t%d\t\t%.2f\t\t%d\t%.2f\t\t%.2f\t%.2f\t\t%.3f\t\t"
+               "%ld/%ld\n",
+               processes[i].pid, processes[i].burst_time,
+               simulated[i].start_time, r->first_run_ms / unit_ms,
+               simulated[i].completion_time, r->completion_ms / unit_ms,
+               r->cpu_ms, r->rusage_ms, latency, r->voluntary_switches,
+               r->involuntary_switches);
+        cpu_total += r->cpu_ms;
+        drift_total +=
+            r->completion_ms / unit_ms - simulated[i].completion_time;
+    }
+    double busy_ms = 0;
+    for (int i = 0; i < n; i++) {
+        busy_ms += processes[i].burst_time * unit_ms;
+    }
+    printf("Switches: %ld, mean cost %.1f us, max %.1f us\n", switches,
+           switches ? switch_total_ms * 1e3 / switches : 0.0,
+           switch_max_ms * 1e3);
+    printf("CPU received: %.1f%% of the scheduled slice time\n",
+           busy_ms > 0 ? 100.0 * cpu_total / busy_ms : 0.0);
+    printf("Mean completion drift: %.3f units\n", drift_total / n);
+    status = 0;
+
+cleanup:
+    for (int i = 0; real != NULL && i < n; i++) {
+        if (real[i].child > 0) {
+            reap(&real[i]);
+        }
+    }
+    if (timer >= 0) {
+        close(timer);
+    }
+    destroy_policy(policy);
+    if (ready != NULL) {
+        free_queue(ready);
+    }
+    free(real);
+    free(simulated);
+    return status;
+}
+
+#else
+
+int run_real_processes(Process processes[], int n, int time_quantum,
+                       double unit_ms, int verbose) {
+    (void)processes;
+    (void)n;
+    (void)time_quantum;
+    (void)unit_ms;
+    (void)verbose;
+    fprintf(stderr, "real-process mode needs Linux (timerfd)\n");
+    return -1;
+}
+
+#endif
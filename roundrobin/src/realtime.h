@@ -0,0 +1,21 @@
+#ifndef REALTIME_H
+#define REALTIME_H
+
+#include "scheduler.h"
+
+// Most child processes run_real_processes will fork
+#define REAL_MAX_PROCESSES 256
+
+// Round robin over real processes (Linux only). Every Process becomes a
+// forked CPU-bound child that is kept stopped until it is scheduled; one
+// time unit is unit_ms milliseconds of wall time. Slices are timed with a
+// timerfd and enforced with SIGCONT/SIGSTOP, and the CPU time each child
+// actually got is read from its CPU clock and from wait4's rusage. The
+// measured timeline is printed next to the simulated one for the same
+// workload, along with the cost of each switch. processes[] must be
+// sorted by arrival time and gets the measured times, in units.
+// Returns 0, or -1 if the mode is unsupported or a child can't be started.
+int run_real_processes(Process processes[], int n, int time_quantum,
+                       double unit_ms, int verbose);
+
+#endif
@@ -0,0 +1,89 @@
+#include "eventlog.h"
+#include "scheduler.h"
+#include <stdio.h>
+#include <string.h>
+
+// Renders a binary event log written by `scheduler --event-log FILE`.
+//
+//   render_log run.log [--format text|gantt|csv]
+//
+// text is the trace the scheduler prints at --log-level text, gantt is
+// one print_gantt_chart_step line per slice, and csv is one row per event:
+// time,end,type,pid,length (pid is -1 for idle time).
+
+typedef enum { FORMAT_TEXT, FORMAT_GANTT, FORMAT_CSV } Format;
+
+static const char *event_names[] = {"arrive", "arrive_during", "run",
+                                    "complete", "idle"};
+
+static void render(const EventRecord *record, Format format) {
+    switch (format) {
+    case FORMAT_TEXT:
+        format_event(stdout, record);
+        break;
+    case FORMAT_GANTT:
+        if (record->type == EVENT_RUN) {
+            print_gantt_chart_step(record->time, record->pid, record->length);
+        }
+        break;
+    case FORMAT_CSV:
+        if (record->type >= EVENT_ARRIVE && record->type <= EVENT_IDLE) {
+            printf("%d,%d,%s,%d,%d\n", record->time,
+                   record->time + record->length, event_names[record->type],
+                   record->pid, record->length);
+        }
+        break;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *path = NULL;
+    Format format = FORMAT_TEXT;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "text") == 0) {
+                format = FORMAT_TEXT;
+            } else if (strcmp(argv[i], "gantt") == 0) {
+                format = FORMAT_GANTT;
+            } else if (strcmp(argv[i], "csv") == 0) {
+                format = FORMAT_CSV;
+            } else {
+                fprintf(stderr, "unknown format '%s'\n", argv[i]);
+                return 1;
+            }
+        } else if (argv[i][0] != '-' && path == NULL) {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "unknown option '%s'\n", argv[i]);
+            return 1;
+        }
+    }
+    if (path == NULL) {
+        fprintf(stderr,
+                "usage: render_log <file> [--format text|gantt|csv]\n");
+        return 1;
+    }
+
+    FILE *log = event_log_open_read(path);
+    if (log == NULL)
+        return 1;
+
+    if (format == FORMAT_CSV) {
+        printf("time,end,type,pid,length\n");
+    }
+    static EventRecord records[EVENT_LOG_BUFFER];
+    size_t count;
+    while ((count = fread(records, sizeof(EventRecord), EVENT_LOG_BUFFER,
+                          log)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            render(&records[i], format);
+        }
+    }
+    int status = ferror(log) ? 1 : 0;
+    if (status != 0) {
+        fprintf(stderr, "error reading %s\n", path);
+    }
+    fclose(log);
+    return status;
+}
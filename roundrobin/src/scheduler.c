@@ -1,55 +1,81 @@
 #include "scheduler.h"
+#include "policy.h"
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 
-Queue *create_queue() {
+Queue *create_queue(int capacity) {
     Queue *queue = malloc(sizeof(Queue));
     if (queue == NULL)
         return NULL;
 
-    queue->front = NULL;
-    queue->rear = NULL;
+    if (capacity < 1)
+        capacity = 1;
+
+    queue->items = malloc((size_t)capacity * sizeof(Process *));
+    if (queue->items == NULL) {
+        free(queue);
+        return NULL;
+    }
+    queue->capacity = capacity;
+    queue->front = 0;
     queue->size = 0;
 
     return queue;
 }
 
+// Grows the buffer to hold at least capacity entries, keeping their
+// order. Returns 0 on success, -1 if the allocation failed.
+int reserve_queue(Queue *queue, int capacity) {
+    if (capacity <= queue->capacity)
+        return 0;
+
+    Process **items = malloc((size_t)capacity * sizeof(Process *));
+    if (items == NULL)
+        return -1;
+
+    for (int i = 0; i < queue->size; i++) {
+        int index = queue->front + i;
+        if (index >= queue->capacity) {
+            index -= queue->capacity;
+        }
+        items[i] = queue->items[index];
+    }
+    free(queue->items);
+    queue->items = items;
+    queue->capacity = capacity;
+    queue->front = 0;
+    return 0;
+}
+
+// The queue must not be full; a process is only ever queued once, so a
+// capacity of n is always enough. Callers that can't bound it that way
+// grow the queue with reserve_queue first.
 void enqueue(Queue *queue, Process *process) {
-    QueueNode *node = malloc(sizeof(QueueNode));
-    node->process = process;
-    node->next = NULL;
-
-    if (queue->rear != NULL) {
-        queue->rear->next = node;
-    } else {
-        queue->front = node;
+    assert(queue->size < queue->capacity);
+    int rear = queue->front + queue->size;
+    if (rear >= queue->capacity) {
+        rear -= queue->capacity;
     }
-    queue->rear = node;
+    queue->items[rear] = process;
     queue->size++;
 }
 
 Process *dequeue(Queue *queue) {
-    if (queue->front == NULL)
+    if (queue->size == 0)
         return NULL;
 
-    QueueNode *node = queue->front;
-    Process *process = node->process;
-
-    queue->front = queue->front->next;
-    if (queue->front == NULL) {
-        queue->rear = NULL;
+    Process *process = queue->items[queue->front];
+    queue->front++;
+    if (queue->front == queue->capacity) {
+        queue->front = 0;
     }
-    free(node);
     queue->size--;
     return process;
 }
 
 void free_queue(Queue *queue) {
-    while (!is_empty(queue)) {
-        dequeue(queue);
-    }
-    queue->rear = NULL;
-    queue->size = 0;
+    free(queue->items);
     free(queue);
 }
 
@@ -60,67 +86,47 @@ void print_gantt_chart_step(int current_time, int pid, int time_slice) {
            pid);
 }
 
-void round_robin_schedule(Process processes[], int n, int time_quantum) {
-    Queue *queue = create_queue();
-
-    int current_time = 0;
-    int completed = 0;
-
-    printf("Starting Round Robin Scheduling...\n");
-    printf("Time Quantum: %d\n\n", time_quantum);
-
-    while (completed < n) {
-        for (int i = 0; i < n; i++) {
-            if (processes[i].arrival_time == current_time) {
-                enqueue(queue, &processes[i]);
-                printf("Time %d: Process P%d arrives\n", current_time,
-                       processes[i].pid);
-            }
-            if (processes[i].arrival_time > current_time) {
-                break;
-            }
-        }
-        if (is_empty(queue)) {
-            printf("Time %d: CPU idle\n", current_time);
-            current_time++;
-            continue;
-        }
+// Round robin on the policy driver. Every step goes to log (NULL for
+// none); the banner lines go to its text stream, if it has one.
+static int run_round_robin(ProcessSource *source, int capacity,
+                           int time_quantum, EventLog *log) {
+    Policy *policy = create_rr_policy(NULL, capacity, time_quantum);
+    if (policy == NULL) {
+        fprintf(stderr, "could not allocate the ready queue\n");
+        return -1;
+    }
 
-        Process *process = dequeue(queue);
-        // set the start time for first time process execution
-        if (process->burst_time == process->remaining_time) {
-            process->start_time = current_time;
-        }
+    FILE *text = log != NULL ? log->text : NULL;
+    if (text != NULL) {
+        fprintf(text, "Starting Round Robin Scheduling...\n");
+        fprintf(text, "Time Quantum: %d\n\n", time_quantum);
+    }
 
-        int execution_time = (process->remaining_time < time_quantum)
-                                 ? process->remaining_time
-                                 : time_quantum;
+    int status = simulate_source(source, policy, log, NULL);
 
-        printf("Time %d-%d: Process P%d executes for %d units\n", current_time,
-               current_time + execution_time, process->pid, execution_time);
+    if (log != NULL) {
+        event_log_flush(log);
+    }
+    if (text != NULL && status == 0) {
+        fprintf(text, "\nAll processes completed!\n");
+    }
+    destroy_policy(policy);
+    return status;
+}
 
-        process->remaining_time -= execution_time;
-        current_time += execution_time;
+void round_robin_schedule(Process processes[], int n, int time_quantum,
+                          EventLog *log) {
+    ArraySource array;
+    ProcessSource source;
+    array_source_init(&source, &array, processes, n);
+    run_round_robin(&source, n, time_quantum, log);
+}
 
-        if (process->remaining_time == 0) {
-            process->completion_time = current_time;
-            completed++;
-            printf("Time %d: Process P%d completed\n", current_time,
-                   process->pid);
-        } else {
-            enqueue(queue, process);
-        }
+// The ready queue starts small and grows with the number of processes
+// live at once
+#define REPLAY_QUEUE 1024
 
-        // add processes that arrived during the execution time
-        for (int i = 0; i < n; i++) {
-            if (processes[i].arrival_time > current_time - execution_time &&
-                processes[i].arrival_time < current_time) {
-                enqueue(queue, &processes[i]);
-                printf("Time %d: Process P%d arrives during execution\n",
-                       current_time, processes[i].pid);
-            }
-        }
-    }
-    printf("\nAll processes completed!\n");
-    free_queue(queue);
+int round_robin_replay(ProcessSource *source, int time_quantum,
+                       EventLog *log) {
+    return run_round_robin(source, REPLAY_QUEUE, time_quantum, log);
 }
@@ -6,27 +6,35 @@ typedef struct {
     int pid;             // Process ID
     int arrival_time;    // When process arrives
     int burst_time;      // Total time needed to complete
+    int priority;        // From the workload, 0 if it has none
     int remaining_time;  // Time left to complete
     int start_time;      // When process first starts executing
     int completion_time; // When process finishes
 } Process;
 
-// Queue node for ready queue
-typedef struct QueueNode {
-    Process *process;
-    struct QueueNode *next;
-} QueueNode;
-
-// Queue structure
+// Ready queue: fixed-capacity ring buffer of process pointers, allocated
+// once by create_queue so enqueue/dequeue never touch the allocator.
+// create_queue takes that capacity up front; enqueueing into a full queue
+// is a bug and trips an assert.
 typedef struct {
-    QueueNode *front;
-    QueueNode *rear;
+    Process **items;
+    int capacity;
+    int front; // index of the oldest entry
     int size;
 } Queue;
 
+struct EventLog;
+struct ProcessSource;
+
 // Function declarations
-void round_robin_schedule(Process processes[], int n, int time_quantum);
-Queue *create_queue(void);
+void round_robin_schedule(Process processes[], int n, int time_quantum,
+                          struct EventLog *log);
+// round_robin_schedule over a source that admits processes as they arrive;
+// returns 0, or -1 if a process couldn't be admitted
+int round_robin_replay(struct ProcessSource *source, int time_quantum,
+                       struct EventLog *log);
+Queue *create_queue(int capacity);
+int reserve_queue(Queue *q, int capacity);
 void enqueue(Queue *q, Process *process);
 Process *dequeue(Queue *q);
 int is_empty(Queue *q);
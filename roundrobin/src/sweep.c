@@ -0,0 +1,151 @@
+#include "sweep.h"
+#include "metrics.h"
+#include "policy.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    Metrics metrics;
+    SimulationStats stats;
+    int ok;
+} SweepRun;
+
+typedef struct {
+    const Process *base;
+    int n;
+    const WorkloadConfig *workload;
+    const SweepConfig *config;
+    SweepRun *runs; // quantum-major, one per (quantum, seed)
+    int run_count;
+    int next_run; // claimed with an atomic increment
+} Sweep;
+
+static void *sweep_worker(void *arg) {
+    Sweep *sweep = arg;
+    Process *processes = malloc((size_t)sweep->n * sizeof(Process));
+    if (processes == NULL)
+        return NULL;
+
+    while (1) {
+        int run = __atomic_fetch_add(&sweep->next_run, 1, __ATOMIC_RELAXED);
+        if (run >= sweep->run_count)
+            break;
+
+        int quantum = sweep->config->quantum_first +
+                      run / sweep->config->seeds * sweep->config->quantum_step;
+        if (sweep->base != NULL) {
+            memcpy(processes, sweep->base,
+                   (size_t)sweep->n * sizeof(Process));
+        } else {
+            WorkloadConfig workload = *sweep->workload;
+            workload.seed += (uint64_t)(run % sweep->config->seeds);
+            generate_workload(processes, sweep->n, &workload);
+        }
+
+        Policy *policy = create_rr_policy(processes, sweep->n, quantum);
+        if (policy == NULL)
+            continue;
+        SweepRun *result = &sweep->runs[run];
+        simulate(processes, sweep->n, policy, NULL, &result->stats);
+        destroy_policy(policy);
+        result->ok =
+            compute_metrics(processes, sweep->n, &result->metrics) == 0;
+    }
+    free(processes);
+    return NULL;
+}
+
+int sweep_row_count(const SweepConfig *config) {
+    if (config->quantum_step <= 0 ||
+        config->quantum_last < config->quantum_first)
+        return 0;
+    return (config->quantum_last - config->quantum_first) /
+               config->quantum_step +
+           1;
+}
+
+int quantum_sweep(const Process base[], int n, const WorkloadConfig *workload,
+                  const SweepConfig *config, SweepRow rows[]) {
+    int row_count = sweep_row_count(config);
+    if (row_count == 0 || config->seeds <= 0 || config->quantum_first <= 0)
+        return -1;
+
+    Sweep sweep;
+    sweep.base = base;
+    sweep.n = n;
+    sweep.workload = workload;
+    sweep.config = config;
+    sweep.run_count = row_count * config->seeds;
+    sweep.next_run = 0;
+    sweep.runs = calloc((size_t)sweep.run_count, sizeof(SweepRun));
+    if (sweep.runs == NULL)
+        return -1;
+
+    int thread_count = config->threads < 1 ? 1 : config->threads;
+    if (thread_count > sweep.run_count) {
+        thread_count = sweep.run_count;
+    }
+    pthread_t *threads = calloc((size_t)thread_count, sizeof(pthread_t));
+    int started = 0;
+    if (threads != NULL) {
+        for (; started < thread_count; started++) {
+            if (pthread_create(&threads[started], NULL, sweep_worker,
+                               &sweep) != 0)
+                break;
+        }
+    }
+    if (started == 0) {
+        // no threads to be had, run them all here
+        sweep_worker(&sweep);
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+
+    int status = 0;
+    for (int r = 0; r < row_count; r++) {
+        SweepRow *row = &rows[r];
+        memset(row, 0, sizeof(*row));
+        row->quantum = config->quantum_first + r * config->quantum_step;
+        for (int s = 0; s < config->seeds; s++) {
+            const SweepRun *run = &sweep.runs[r * config->seeds + s];
+            if (!run->ok) {
+                status = -1;
+                continue;
+            }
+            row->runs++;
+            row->mean_turnaround += run->metrics.mean_turnaround;
+            row->p99_turnaround += run->metrics.p99_turnaround;
+            row->mean_waiting += run->metrics.mean_waiting;
+            row->p99_waiting += run->metrics.p99_waiting;
+            row->mean_response += run->metrics.mean_response;
+            row->p99_response += run->metrics.p99_response;
+            row->context_switches += (double)run->stats.context_switches;
+        }
+        if (row->runs > 0) {
+            row->mean_turnaround /= row->runs;
+            row->p99_turnaround /= row->runs;
+            row->mean_waiting /= row->runs;
+            row->p99_waiting /= row->runs;
+            row->mean_response /= row->runs;
+            row->p99_response /= row->runs;
+            row->context_switches /= row->runs;
+        }
+    }
+    free(sweep.runs);
+    return status;
+}
+
+void write_sweep_csv(FILE *file, const SweepRow rows[], int count) {
+    fprintf(file, "quantum,runs,mean_turnaround,p99_turnaround,mean_waiting,"
+                  "p99_waiting,mean_response,p99_response,context_switches\n");
+    for (int i = 0; i < count; i++) {
+        const SweepRow *row = &rows[i];
+        fprintf(file, "%d,%d,%.3f,%.1f,%.3f,%.1f,%.3f,%.1f,%.1f\n",
+                row->quantum, row->runs, row->mean_turnaround,
+                row->p99_turnaround, row->mean_waiting, row->p99_waiting,
+                row->mean_response, row->p99_response, row->context_switches);
+    }
+}
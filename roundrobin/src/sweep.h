@@ -0,0 +1,44 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "scheduler.h"
+#include "workload.h"
+#include <stdio.h>
+
+typedef struct {
+    int quantum_first;
+    int quantum_last;
+    int quantum_step;
+    int seeds;   // runs per quantum
+    int threads; // runs in flight at once
+} SweepConfig;
+
+// One quantum, averaged over its runs
+typedef struct {
+    int quantum;
+    int runs;
+    double mean_turnaround;
+    double p99_turnaround;
+    double mean_waiting;
+    double p99_waiting;
+    double mean_response;
+    double p99_response;
+    double context_switches;
+} SweepRow;
+
+// Number of rows quantum_sweep fills for config
+int sweep_row_count(const SweepConfig *config);
+
+// Runs round robin for every quantum in the range on config->seeds
+// workloads, spread over config->threads threads. Every run simulates its
+// own private copy of the processes, quietly. With base set, all runs use
+// copies of base[0..n) and seeds only repeats them; otherwise run k of a
+// quantum uses the workload generated with seed workload->seed + k. The
+// rows don't depend on the thread count. Returns 0, or -1 on allocation
+// failure.
+int quantum_sweep(const Process base[], int n, const WorkloadConfig *workload,
+                  const SweepConfig *config, SweepRow rows[]);
+
+void write_sweep_csv(FILE *file, const SweepRow rows[], int count);
+
+#endif
@@ -0,0 +1,209 @@
+#define _POSIX_C_SOURCE 200809L
+#include "trace.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char trace_magic[8] = {'R', 'R', 'T', 'R', 'A', 'C', 'E', '\0'};
+
+// Records per fwrite in trace_write
+#define TRACE_WRITE_BATCH 4096
+
+// Slots per allocation in a TraceSource pool
+#define TRACE_CHUNK 4096
+
+struct TraceSlot {
+    union {
+        Process process;
+        TraceSlot *next_free;
+    } u;
+};
+
+struct TraceChunk {
+    TraceChunk *next;
+    TraceSlot slots[TRACE_CHUNK];
+};
+
+int trace_open(Trace *trace, const char *path) {
+    memset(trace, 0, sizeof(*trace));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "could not open trace %s\n", path);
+        return -1;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(TraceHeader)) {
+        fprintf(stderr, "%s is not a trace\n", path);
+        close(fd);
+        return -1;
+    }
+
+    size_t length = (size_t)info.st_size;
+    void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        fprintf(stderr, "could not map trace %s\n", path);
+        return -1;
+    }
+
+    const TraceHeader *header = mapping;
+    if (memcmp(header->magic, trace_magic, sizeof(trace_magic)) != 0 ||
+        header->version != TRACE_VERSION ||
+        header->record_size != sizeof(TraceRecord) || header->count == 0 ||
+        header->count > INT_MAX ||
+        length != sizeof(TraceHeader) + header->count * sizeof(TraceRecord)) {
+        fprintf(stderr, "%s is not a version %d trace\n", path, TRACE_VERSION);
+        munmap(mapping, length);
+        return -1;
+    }
+
+    // every reader goes front to back once; the kernel reads ahead and
+    // can drop the pages behind it
+    posix_madvise(mapping, length, POSIX_MADV_SEQUENTIAL);
+    trace->path = path;
+    trace->records =
+        (const TraceRecord *)((const char *)mapping + sizeof(TraceHeader));
+    trace->count = (int)header->count;
+    trace->mapping = mapping;
+    trace->length = length;
+    return 0;
+}
+
+void trace_close(Trace *trace) {
+    if (trace->mapping != NULL) {
+        munmap(trace->mapping, trace->length);
+    }
+    memset(trace, 0, sizeof(*trace));
+}
+
+// Record i as a process that hasn't run yet, or -1 if it arrives before
+// record i - 1
+static int load_record(const Trace *trace, int i, Process *process) {
+    const TraceRecord *record = &trace->records[i];
+    if (i > 0 && record->arrival_time < trace->records[i - 1].arrival_time) {
+        fprintf(stderr,
+                "%s: record %d arrives before the one ahead of it; "
+                "traces must be sorted by arrival time\n",
+                trace->path, i);
+        return -1;
+    }
+    process->pid = record->pid;
+    process->arrival_time = record->arrival_time;
+    process->burst_time = record->burst_time;
+    process->priority = record->priority;
+    process->remaining_time = record->burst_time;
+    process->start_time = 0;
+    process->completion_time = 0;
+    return 0;
+}
+
+int trace_read(const Trace *trace, Process processes[]) {
+    for (int i = 0; i < trace->count; i++) {
+        if (load_record(trace, i, &processes[i]) != 0)
+            return -1;
+    }
+    return 0;
+}
+
+static int trace_next_arrival(ProcessSource *source) {
+    TraceSource *trace_source = source->state;
+    return trace_source->trace->records[trace_source->next].arrival_time;
+}
+
+static Process *trace_admit(ProcessSource *source) {
+    TraceSource *trace_source = source->state;
+    TraceSlot *slot = trace_source->free_slots;
+    if (slot != NULL) {
+        trace_source->free_slots = slot->u.next_free;
+    } else {
+        TraceChunk *chunk = trace_source->chunks;
+        if (chunk == NULL || trace_source->chunk_used == TRACE_CHUNK) {
+            chunk = malloc(sizeof(TraceChunk));
+            if (chunk == NULL) {
+                fprintf(stderr, "out of memory for live processes\n");
+                return NULL;
+            }
+            chunk->next = trace_source->chunks;
+            trace_source->chunks = chunk;
+            trace_source->chunk_used = 0;
+        }
+        slot = &chunk->slots[trace_source->chunk_used++];
+    }
+
+    Process *process = &slot->u.process;
+    if (load_record(trace_source->trace, trace_source->next, process) != 0)
+        return NULL;
+    trace_source->next++;
+    return process;
+}
+
+static void trace_release(ProcessSource *source, Process *process) {
+    TraceSource *trace_source = source->state;
+    if (trace_source->finished != NULL) {
+        trace_source->finished(trace_source->context, process);
+    }
+    // the process is the slot's first member
+    TraceSlot *slot = (TraceSlot *)process;
+    slot->u.next_free = trace_source->free_slots;
+    trace_source->free_slots = slot;
+}
+
+void trace_source_init(TraceSource *source, const Trace *trace,
+                       void (*finished)(void *context,
+                                        const Process *process),
+                       void *context) {
+    memset(source, 0, sizeof(*source));
+    source->source.state = source;
+    source->source.count = trace->count;
+    source->source.next_arrival = trace_next_arrival;
+    source->source.admit = trace_admit;
+    source->source.release = trace_release;
+    source->trace = trace;
+    source->finished = finished;
+    source->context = context;
+}
+
+void trace_source_free(TraceSource *source) {
+    while (source->chunks != NULL) {
+        TraceChunk *next = source->chunks->next;
+        free(source->chunks);
+        source->chunks = next;
+    }
+    source->free_slots = NULL;
+}
+
+int trace_write(const char *path, const Process processes[], int n) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+        return -1;
+
+    TraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, trace_magic, sizeof(trace_magic));
+    header.version = TRACE_VERSION;
+    header.record_size = sizeof(TraceRecord);
+    header.count = (uint64_t)n;
+
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    static TraceRecord batch[TRACE_WRITE_BATCH];
+    for (int i = 0; ok && i < n; i += TRACE_WRITE_BATCH) {
+        int size = n - i < TRACE_WRITE_BATCH ? n - i : TRACE_WRITE_BATCH;
+        for (int j = 0; j < size; j++) {
+            const Process *process = &processes[i + j];
+            batch[j].pid = process->pid;
+            batch[j].arrival_time = process->arrival_time;
+            batch[j].burst_time = process->burst_time;
+            batch[j].priority = process->priority;
+        }
+        ok = fwrite(batch, sizeof(TraceRecord), (size_t)size, file) ==
+             (size_t)size;
+    }
+    ok = fclose(file) == 0 && ok;
+    return ok ? 0 : -1;
+}
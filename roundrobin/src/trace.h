@@ -0,0 +1,78 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "policy.h"
+#include "scheduler.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Binary workload trace: a header followed by count records, sorted by
+// arrival time. Records hold only the workload, never simulation state,
+// so the format doesn't change when Process does. The file is in host
+// byte order.
+typedef struct {
+    char magic[8];        // "RRTRACE\0"
+    uint32_t version;
+    uint32_t record_size; // sizeof(TraceRecord)
+    uint64_t count;
+} TraceHeader;
+
+typedef struct {
+    int32_t pid;
+    int32_t arrival_time;
+    int32_t burst_time;
+    int32_t priority;
+} TraceRecord;
+
+// Version 1 stored whole Process structs
+#define TRACE_VERSION 2
+
+typedef struct {
+    const char *path;
+    const TraceRecord *records; // in the read-only mapping
+    int count;
+    void *mapping;
+    size_t length;
+} Trace;
+
+// Maps path read-only and checks its header; the records are paged in as
+// they are read and can be dropped again, so the trace may be larger than
+// RAM. Returns 0, or -1 with a message on stderr if it isn't a trace.
+int trace_open(Trace *trace, const char *path);
+void trace_close(Trace *trace);
+
+// Fills processes[0..trace->count) for the modes that need every process
+// at once. Returns 0, or -1 with a message on stderr if the arrivals
+// aren't sorted.
+int trace_read(const Trace *trace, Process processes[]);
+
+// A ProcessSource over the mapped records. Admitted processes get a slot
+// from a pool that finished ones go back to, so memory follows the number
+// of live processes, not the length of the trace.
+typedef struct TraceSlot TraceSlot;
+typedef struct TraceChunk TraceChunk;
+typedef struct {
+    ProcessSource source;
+    const Trace *trace;
+    int next; // record admitted next
+    TraceSlot *free_slots;
+    TraceChunk *chunks;
+    int chunk_used; // slots handed out from the newest chunk
+    // called with each process as it finishes, before its slot is reused
+    void (*finished)(void *context, const Process *process);
+    void *context;
+} TraceSource;
+
+// finished may be NULL. Admitting fails, with a message on stderr, on an
+// arrival that goes backwards or when the pool can't grow.
+void trace_source_init(TraceSource *source, const Trace *trace,
+                       void (*finished)(void *context,
+                                        const Process *process),
+                       void *context);
+void trace_source_free(TraceSource *source);
+
+// Writes processes[0..n), which must be sorted by arrival time, as a
+// trace. Returns 0, or -1 if the file can't be written.
+int trace_write(const char *path, const Process processes[], int n);
+
+#endif
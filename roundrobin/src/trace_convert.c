@@ -0,0 +1,103 @@
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Converts a CSV workload to a binary trace for `scheduler --trace`.
+//
+//   trace_convert jobs.csv jobs.trace
+//
+// One process per line: pid,arrival,burst[,priority]. Lines that don't
+// start with a number (headers, comments) are skipped. The output is
+// sorted by arrival time, keeping the input order for equal arrivals.
+
+static int compare_arrival_then_line(const void *a, const void *b) {
+    const Process *processA = a;
+    const Process *processB = b;
+    if (processA->arrival_time != processB->arrival_time)
+        return processA->arrival_time < processB->arrival_time ? -1 : 1;
+    // completion_time holds the input line while sorting
+    return (processA->completion_time > processB->completion_time) -
+           (processA->completion_time < processB->completion_time);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: trace_convert <input.csv> <output.trace>\n");
+        return 1;
+    }
+
+    FILE *input = fopen(argv[1], "r");
+    if (input == NULL) {
+        fprintf(stderr, "could not open %s\n", argv[1]);
+        return 1;
+    }
+
+    Process *processes = NULL;
+    int count = 0;
+    int capacity = 0;
+    int sorted = 1;
+    char line[256];
+    int line_number = 0;
+
+    while (fgets(line, sizeof(line), input) != NULL) {
+        line_number++;
+        int pid, arrival, burst, priority = 0;
+        int fields = sscanf(line, "%d ,%d ,%d ,%d", &pid, &arrival, &burst,
+                            &priority);
+        if (fields < 1)
+            continue;
+        if (fields < 3 || arrival < 0 || burst < 0) {
+            fprintf(stderr, "%s:%d: expected pid,arrival,burst[,priority]\n",
+                    argv[1], line_number);
+            fclose(input);
+            free(processes);
+            return 1;
+        }
+
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 1024;
+            Process *grown =
+                realloc(processes, (size_t)capacity * sizeof(Process));
+            if (grown == NULL) {
+                fprintf(stderr, "out of memory after %d processes\n", count);
+                fclose(input);
+                free(processes);
+                return 1;
+            }
+            processes = grown;
+        }
+        Process *process = &processes[count];
+        process->pid = pid;
+        process->arrival_time = arrival;
+        process->burst_time = burst;
+        process->priority = priority;
+        process->remaining_time = burst;
+        process->start_time = 0;
+        process->completion_time = count;
+        if (count > 0 && arrival < processes[count - 1].arrival_time) {
+            sorted = 0;
+        }
+        count++;
+    }
+    fclose(input);
+
+    if (count == 0) {
+        fprintf(stderr, "%s has no processes\n", argv[1]);
+        return 1;
+    }
+    if (!sorted) {
+        qsort(processes, count, sizeof(Process), compare_arrival_then_line);
+    }
+    for (int i = 0; i < count; i++) {
+        processes[i].completion_time = 0;
+    }
+
+    if (trace_write(argv[2], processes, count) != 0) {
+        fprintf(stderr, "could not write %s\n", argv[2]);
+        free(processes);
+        return 1;
+    }
+    printf("wrote %d processes to %s\n", count, argv[2]);
+    free(processes);
+    return 0;
+}
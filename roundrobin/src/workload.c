@@ -0,0 +1,135 @@
+#include "workload.h"
+#include <math.h>
+#include <stdlib.h>
+
+// splitmix64 spreads any seed, even 0, over the whole xoshiro state
+void rng_seed(Rng *rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        uint64_t z = (seed += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        rng->s[i] = z ^ (z >> 31);
+    }
+}
+
+// Exponential with the given mean; 1 - u keeps log away from 0
+static double rng_exponential(Rng *rng, double mean) {
+    return -mean * log(1.0 - rng_uniform(rng));
+}
+
+void workload_defaults(WorkloadConfig *config) {
+    config->seed = 1;
+    config->arrivals = ARRIVAL_POISSON;
+    config->arrival_rate = 0.25;
+    config->burstiness = 10.0;
+    config->burst_period = 50.0;
+    config->bursts = BURST_EXPONENTIAL;
+    config->mean_burst = 3.0;
+    config->long_burst = 30.0;
+    config->long_fraction = 0.1;
+    config->pareto_shape = 1.5;
+    config->max_burst = 1000000;
+    config->demo = 0;
+}
+
+static int compare_arrival_time(const void *a, const void *b) {
+    const Process *processA = a;
+    const Process *processB = b;
+
+    return processA->arrival_time - processB->arrival_time;
+}
+
+static void generate_demo_workload(Process processes[], int n,
+                                   uint64_t seed) {
+    Rng rng;
+    rng_seed(&rng, seed);
+    for (int i = 0; i < n; i++) {
+        processes[i].pid = i;
+        processes[i].arrival_time = rng_below(&rng, 31);
+        processes[i].burst_time = rng_below(&rng, 20);
+        processes[i].priority = 0;
+        processes[i].completion_time = 0;
+        processes[i].remaining_time = processes[i].burst_time;
+        processes[i].start_time = 0;
+    }
+
+    qsort(processes, n, sizeof(Process), compare_arrival_time);
+    processes[0].arrival_time = 0;
+    processes[0].burst_time = 6;
+    processes[0].remaining_time = processes[0].burst_time;
+}
+
+static int sample_burst(Rng *rng, const WorkloadConfig *config) {
+    double burst;
+    switch (config->bursts) {
+    case BURST_BIMODAL:
+        burst = rng_exponential(rng, rng_uniform(rng) < config->long_fraction
+                                         ? config->long_burst
+                                         : config->mean_burst);
+        break;
+    case BURST_PARETO: {
+        // scale chosen so the mean comes out at mean_burst
+        double shape = config->pareto_shape;
+        double scale = config->mean_burst * (shape - 1.0) / shape;
+        burst = scale / pow(1.0 - rng_uniform(rng), 1.0 / shape);
+        break;
+    }
+    case BURST_EXPONENTIAL:
+    default:
+        burst = rng_exponential(rng, config->mean_burst);
+        break;
+    }
+
+    if (burst >= config->max_burst)
+        return config->max_burst;
+    return burst < 1.0 ? 1 : (int)(burst + 0.5);
+}
+
+void generate_workload(Process processes[], int n,
+                       const WorkloadConfig *config) {
+    if (config->demo) {
+        generate_demo_workload(processes, n, config->seed);
+        return;
+    }
+
+    Rng rng;
+    rng_seed(&rng, config->seed);
+
+    // keep the long-run rate at arrival_rate: the busy and quiet rates
+    // average to it and differ by a factor of burstiness
+    double busy_rate = 2.0 * config->arrival_rate * config->burstiness /
+                       (config->burstiness + 1.0);
+    double quiet_rate = 2.0 * config->arrival_rate / (config->burstiness + 1.0);
+    int busy = 1;
+    double switch_at = rng_exponential(&rng, config->burst_period);
+
+    double time = 0.0;
+    for (int i = 0; i < n; i++) {
+        if (config->arrivals == ARRIVAL_BURSTY) {
+            // gaps are memoryless, so crossing a switch can just start a
+            // fresh gap at the new rate from the switch point
+            while (1) {
+                double gap = rng_exponential(&rng, 1.0 / (busy ? busy_rate
+                                                                : quiet_rate));
+                if (time + gap < switch_at) {
+                    time += gap;
+                    break;
+                }
+                time = switch_at;
+                busy = !busy;
+                switch_at = time + rng_exponential(&rng, config->burst_period);
+            }
+        } else {
+            time += rng_exponential(&rng, 1.0 / config->arrival_rate);
+        }
+
+        Process *process = &processes[i];
+        process->pid = i;
+        process->arrival_time = (int)time;
+        process->burst_time = sample_burst(&rng, config);
+        process->priority = 0;
+        process->remaining_time = process->burst_time;
+        process->start_time = 0;
+        process->completion_time = 0;
+    }
+}
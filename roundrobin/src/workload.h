@@ -0,0 +1,79 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "scheduler.h"
+#include <stdint.h>
+
+// xoshiro256** PRNG: fast, small state, and the same sequence for a
+// given seed on every platform
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+void rng_seed(Rng *rng, uint64_t seed);
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t rng_next(Rng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+// Uniform in [0, 1)
+static inline double rng_uniform(Rng *rng) {
+    return (double)(rng_next(rng) >> 11) * 0x1.0p-53;
+}
+
+// Uniform in [0, limit), limit > 0
+static inline int rng_below(Rng *rng, int limit) {
+    return (int)(((rng_next(rng) >> 32) * (uint64_t)limit) >> 32);
+}
+
+typedef enum {
+    ARRIVAL_POISSON, // exponential gaps at arrival_rate
+    ARRIVAL_BURSTY,  // Poisson switching between a busy and a quiet rate
+} ArrivalProcess;
+
+typedef enum {
+    BURST_EXPONENTIAL, // mean mean_burst
+    BURST_BIMODAL,     // exponential around mean_burst, or around
+                       // long_burst for long_fraction of the processes
+    BURST_PARETO,      // heavy tailed with mean mean_burst
+} BurstDistribution;
+
+typedef struct {
+    uint64_t seed;
+    ArrivalProcess arrivals;
+    double arrival_rate; // mean arrivals per time unit, overall
+    double burstiness;   // ARRIVAL_BURSTY: busy rate / quiet rate
+    double burst_period; // ARRIVAL_BURSTY: mean length of a busy or quiet
+                         // period
+    BurstDistribution bursts;
+    double mean_burst;
+    double long_burst;    // BURST_BIMODAL
+    double long_fraction; // BURST_BIMODAL
+    double pareto_shape;  // BURST_PARETO, > 1
+    int max_burst;        // bursts are clamped to [1, max_burst]
+    int demo; // the scheduler's original demo workload instead: arrivals
+              // uniform in [0, 30], bursts in [0, 20), P0 arriving at 0
+} WorkloadConfig;
+
+// Poisson arrivals at 0.25 per unit with exponential bursts of mean 3
+void workload_defaults(WorkloadConfig *config);
+
+// Fills processes[0..n) with pids 0..n-1. Arrival times come out sorted;
+// the same config and seed give the same workload.
+void generate_workload(Process processes[], int n,
+                       const WorkloadConfig *config);
+
+#endif